@@ -31,7 +31,29 @@ local project_list = {
     "AG_11_02",
     "AG_12_01",
     "AG_12_02",
-    "AG_13"
+    "AG_13",
+    "BM_01",
+    "BM_02",
+    "BM_03",
+    "BM_04",
+    "BM_05",
+    "BM_06",
+    "BM_07",
+    "BM_08",
+    "BM_09",
+    "BM_10",
+    "BM_11",
+    "BM_12",
+    "BM_13",
+    "BM_14",
+    "BM_15",
+    "BM_16",
+    "BM_17",
+    "BM_18",
+    "BM_19",
+    "BM_20",
+    "BM_21",
+    "BM_22"
 }
 
 local function new_project(name)
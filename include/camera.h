@@ -2,6 +2,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "frustum_cull.h"
+
 // Default Camera Values
 const float k_Yaw = -90.0f;
 const float k_Pitch = 0.0f;
@@ -30,6 +32,10 @@ class Camera {
 			const float yaw, const float pitch);
 		
 		glm::mat4 getViewMatrix() const; // Returns current view matrix
+		// Returns the perspective projection of the current FOV
+		glm::mat4 getProjectionMatrix(const float aspect, const float zNear, const float zFar) const;
+		// Returns the world space planes of the current view and projection
+		Frustum getFrustum(const float aspect, const float zNear, const float zFar) const;
 		float getFOV() const; // Returns the FOV
 		glm::vec3 Camera::getPosition() const; // Returns position
 		
@@ -0,0 +1,54 @@
+#ifndef __FRAME_UNIFORMS_H__
+#define __FRAME_UNIFORMS_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstdint>
+
+class Camera;
+
+// Uniform block every program can declare to read the per-frame values:
+//
+// layout (std140) uniform Frame {
+//     mat4 projection;
+//     mat4 view;
+//     mat4 lightSpaceMatrix;
+//     vec3 viewPos;
+//     vec3 lightPos;
+// };
+//
+// Shader binds it to k_FrameBlockBinding at link time.
+const char* const k_FrameBlockName = "Frame";
+const uint32_t k_FrameBlockBinding = 0;
+
+// CPU mirror of the Frame block in std140 layout
+struct FrameData {
+	glm::mat4 projection;
+	glm::mat4 view;
+	glm::mat4 lightSpaceMatrix;
+	glm::vec4 viewPos; // xyz, std140 pads a vec3 to 16 bytes
+	glm::vec4 lightPos;
+};
+
+// Uniform buffer behind the Frame block. Filled on the CPU during the frame and
+// uploaded once, then read by every program that declares the block.
+class FrameUniforms {
+	public:
+		FrameUniforms();
+		FrameUniforms(const FrameUniforms&) = delete;
+		FrameUniforms& operator=(const FrameUniforms&) = delete;
+		~FrameUniforms();
+
+		void setCamera(const Camera& camera, const float aspect, const float near, const float far);
+		void setCamera(const glm::mat4& projection, const glm::mat4& view, const glm::vec3& position);
+		void setLight(const glm::vec3& position, const glm::mat4& lightSpaceMatrix);
+		// One glBufferSubData for the whole block, also rebinds it to k_FrameBlockBinding
+		void upload() const;
+
+		const FrameData& data() const { return data_; }
+
+	private:
+		FrameData data_;
+		uint32_t UBO_ = 0;
+};
+
+#endif
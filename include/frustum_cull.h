@@ -0,0 +1,76 @@
+#ifndef __FRUSTUM_CULL_H__
+#define __FRUSTUM_CULL_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Mesh;
+
+// Six planes (a, b, c, d) facing inwards, a point p is inside a plane when
+// dot(abc, p) + d >= 0. Planes are normalized, so d is a distance.
+struct Frustum {
+	enum Plane {
+		Left = 0,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far,
+		Count
+	};
+
+	glm::vec4 planes[Count];
+
+	// Planes of the clip volume of viewProj, in the space viewProj maps from (world for proj * view)
+	static Frustum fromMatrix(const glm::mat4& viewProj);
+
+	// Scalar test of one bounding volume, see cullBounds()
+	bool intersects(const glm::vec3& center, const glm::vec3& extents, const float radius) const;
+};
+
+// Instruction sets cullBounds() can test with, wider ones only when compiled in (/arch:AVX, -mavx)
+enum class CullPath : uint32_t {
+	Scalar = 0, // 1 volume per iteration
+	SSE, // 4 volumes per iteration
+	AVX // 8 volumes per iteration
+};
+
+// Bounding volumes in structure of arrays layout, so a SIMD register loads the same
+// component of 4 or 8 consecutive volumes. Each volume is an AABB (center, half extents)
+// together with the bounding sphere around the same center.
+class CullBounds {
+	public:
+		void clear();
+		void reserve(const size_t count);
+		size_t size() const { return radius_.size(); }
+		glm::vec3 center(const uint32_t i) const { return glm::vec3(centerX_[i], centerY_[i], centerZ_[i]); }
+		glm::vec3 extents(const uint32_t i) const { return glm::vec3(extentX_[i], extentY_[i], extentZ_[i]); }
+		float radius(const uint32_t i) const { return radius_[i]; }
+
+		// Returns the index reported by cullBounds()
+		uint32_t add(const glm::vec3& center, const glm::vec3& extents, const float radius);
+		// World bounds of mesh placed by model: the AABB around its transformed box and the sphere scaled by the largest axis
+		uint32_t add(const Mesh& mesh, const glm::mat4& model);
+
+	private:
+		friend void cullBounds(const Frustum&, const CullBounds&, std::vector<uint32_t>*, const CullPath);
+
+		std::vector<float> centerX_, centerY_, centerZ_;
+		std::vector<float> extentX_, extentY_, extentZ_;
+		std::vector<float> radius_;
+};
+
+CullPath bestCullPath();
+const char* cullPathName(const CullPath path);
+
+// Appends to visible the index of every volume not entirely behind one of the planes.
+// A volume is culled when either its sphere or its box lies entirely outside a plane,
+// i.e. its center is further than min(radius, projected AABB extent) on the outer side.
+// Both bounds contain the geometry, so either one is enough to reject it. Like any plane
+// test it keeps some volumes near the frustum corners that are outside.
+// path is lowered to bestCullPath() when not compiled in.
+void cullBounds(const Frustum& frustum, const CullBounds& bounds, std::vector<uint32_t>* visible,
+	const CullPath path = CullPath::AVX);
+
+#endif
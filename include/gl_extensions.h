@@ -0,0 +1,64 @@
+#ifndef __GL_EXTENSIONS_H__
+#define __GL_EXTENSIONS_H__ 1
+
+#include <glad/glad.h>
+
+// Entry points beyond the GL 3.3 core loaded by glad. Every group comes either from
+// the core version that adopted it or from the matching extension, and its flag is
+// false (pointers null) when the driver offers neither.
+
+// GL 4.1 / ARB_get_program_binary
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+// KHR_parallel_shader_compile / ARB_parallel_shader_compile
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+// GL 4.3 / ARB_multi_draw_indirect, which builds on GL 4.0 / ARB_draw_indirect and
+// GL 4.2 / ARB_base_instance (baseInstance of the commands)
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+// GL 4.4 / ARB_buffer_storage
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+struct GLExtensions {
+	bool programBinary = false;
+	PFNGLGETPROGRAMBINARYPROC getProgramBinary = nullptr;
+	PFNGLPROGRAMBINARYPROC programBinaryLoad = nullptr;
+	PFNGLPROGRAMPARAMETERIPROC programParameteri = nullptr;
+
+	// Compiles and links run on driver threads, GL_COMPLETION_STATUS_KHR polls them
+	bool parallelShaderCompile = false;
+	PFNGLMAXSHADERCOMPILERTHREADSKHRPROC maxShaderCompilerThreads = nullptr;
+
+	// Every draw of a GL_DRAW_INDIRECT_BUFFER in one call
+	bool multiDrawIndirect = false;
+	PFNGLMULTIDRAWELEMENTSINDIRECTPROC multiDrawElementsIndirect = nullptr;
+
+	// Immutable storage that can stay mapped while GL reads from it
+	bool bufferStorage = false;
+	PFNGLBUFFERSTORAGEPROC createBufferStorage = nullptr;
+};
+
+// Loads the entry points through the context's proc address function on first use,
+// so a context must be current
+const GLExtensions& glExtensions();
+
+bool hasGLVersion(const int major, const int minor);
+bool hasGLExtension(const char* name);
+
+#endif
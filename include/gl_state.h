@@ -0,0 +1,86 @@
+#ifndef __GL_STATE_H__
+#define __GL_STATE_H__ 1
+
+#include <cstdint>
+
+// State changes issued vs elided because GL already held the requested state
+struct GLStateStats {
+	uint64_t issued = 0;
+	uint64_t elided = 0;
+};
+
+// Shadow of the binding and fixed-function state of the GL context. A request for the
+// state GL already holds issues no call. Everything starts unknown, so the first request
+// of each state is always issued. Code changing this state with direct GL calls must
+// call invalidate() afterwards, or the shadow goes stale. GL thread only.
+class GLState {
+	public:
+		static GLState& instance();
+
+		void useProgram(const uint32_t program);
+		void bindVertexArray(const uint32_t VAO);
+		void bindFramebuffer(const uint32_t FBO); // GL_FRAMEBUFFER, read and draw
+		// Switches the active unit only when the binding actually changes
+		void bindTexture(const uint32_t unit, const uint32_t target, const uint32_t texture);
+		void activeTexture(const uint32_t unit);
+
+		void setBlend(const bool enabled);
+		void blendFunc(const uint32_t src, const uint32_t dst);
+		void setDepthTest(const bool enabled);
+		void depthFunc(const uint32_t func);
+		void depthMask(const bool write);
+		void setStencilTest(const bool enabled);
+		void stencilFunc(const uint32_t func, const int32_t ref, const uint32_t mask);
+		void stencilOp(const uint32_t stencilFail, const uint32_t depthFail, const uint32_t depthPass);
+		void stencilMask(const uint32_t mask);
+		void setCullFace(const bool enabled);
+		void cullFace(const uint32_t mode);
+
+		// GL unbinds deleted objects and may hand their names out again
+		void forgetProgram(const uint32_t program);
+		void forgetVertexArray(const uint32_t VAO);
+		void forgetFramebuffer(const uint32_t FBO);
+		void forgetTexture(const uint32_t texture);
+		// Forgets everything, e.g. after direct GL calls
+		void invalidate();
+
+		// With elision off every request is issued, for comparisons
+		void setElision(const bool enabled);
+
+		const GLStateStats& stats() const { return stats_; }
+		void resetStats() { stats_ = GLStateStats(); }
+
+	private:
+		static const uint32_t k_MaxTextureUnits = 32;
+		static const uint32_t k_TextureTargets = 3; // 2D, cube map, buffer
+
+		GLState();
+
+		// Stores the values and returns true when they differ from the shadow
+		bool changed(uint32_t* current, const uint32_t* values, const uint32_t count);
+		bool changed(uint32_t& current, const uint32_t value) { return changed(&current, &value, 1); }
+		void setCapability(uint32_t& current, const uint32_t capability, const bool enabled);
+
+		uint32_t program_;
+		uint32_t VAO_;
+		uint32_t FBO_;
+		uint32_t activeUnit_;
+		uint32_t textures_[k_MaxTextureUnits][k_TextureTargets];
+
+		uint32_t blend_;
+		uint32_t blendFunc_[2];
+		uint32_t depthTest_;
+		uint32_t depthFunc_;
+		uint32_t depthMask_;
+		uint32_t stencilTest_;
+		uint32_t stencilFunc_[3];
+		uint32_t stencilOp_[3];
+		uint32_t stencilMask_;
+		uint32_t cullFace_;
+		uint32_t cullFaceMode_;
+
+		bool elision_ = true;
+		GLStateStats stats_;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef __INDIRECT_DRAW_H__
+#define __INDIRECT_DRAW_H__ 1
+
+#include <cstdint>
+#include <vector>
+
+class Mesh;
+class Shader;
+
+// Layout GL reads from a GL_DRAW_INDIRECT_BUFFER
+struct DrawElementsIndirectCommand {
+	uint32_t count;
+	uint32_t instanceCount;
+	uint32_t firstIndex;
+	int32_t baseVertex;
+	uint32_t baseInstance;
+};
+
+// Material index of every draw, an integer attribute read once per draw:
+//   layout (location = 12) in uint aMaterialIndex;
+const uint32_t k_MaterialIndexLocation = 12;
+
+// GL calls vs draws they carried, over every IndirectDrawList
+struct IndirectDrawStats {
+	uint64_t calls = 0;
+	uint64_t draws = 0;
+};
+
+// Draw commands of every mesh sharing one VAO (a consolidated Model), built once.
+// Meshes are grouped by texture set, their material, and a group's textures are
+// bound once for all its draws. Programs that sample no texture draw every group in a
+// single call. With GL 4.3 / ARB_multi_draw_indirect the commands live in a buffer and
+// go out with glMultiDrawElementsIndirect, baseInstance indexing the material buffer.
+// Without it each group goes out with glMultiDrawElementsBaseVertex and the material
+// index as a constant attribute value.
+class IndirectDrawList {
+	public:
+		IndirectDrawList(const std::vector<Mesh>& meshes, const uint32_t VAO, const uint32_t indexSize);
+		IndirectDrawList(const IndirectDrawList&) = delete;
+		IndirectDrawList& operator=(const IndirectDrawList&) = delete;
+		~IndirectDrawList();
+
+		// meshes must be the ones the list was built from
+		void draw(const Shader& shader, const std::vector<Mesh>& meshes) const;
+
+		uint32_t drawCount() const { return static_cast<uint32_t>(commands_.size()); }
+		uint32_t materialCount() const { return static_cast<uint32_t>(groups_.size()); }
+		bool usesIndirectBuffer() const { return commandBuffer_ != 0; }
+
+		static const IndirectDrawStats& stats();
+		static void resetStats();
+
+	private:
+		// Consecutive commands sharing a material
+		struct Group {
+			uint32_t first;
+			uint32_t count;
+			uint32_t mesh; // binds the textures of the group
+		};
+
+		void submit(const uint32_t first, const uint32_t count, const uint32_t material) const;
+
+		std::vector<DrawElementsIndirectCommand> commands_;
+		std::vector<Group> groups_;
+		// glMultiDrawElementsBaseVertex arrays, in command order
+		std::vector<int32_t> counts_;
+		std::vector<const void*> offsets_;
+		std::vector<int32_t> baseVertices_;
+
+		uint32_t VAO_;
+		uint32_t indexType_;
+		uint32_t commandBuffer_ = 0;
+		uint32_t materialBuffer_ = 0;
+};
+
+#endif
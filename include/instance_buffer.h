@@ -0,0 +1,53 @@
+#ifndef __INSTANCE_BUFFER_H__
+#define __INSTANCE_BUFFER_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Attribute locations of the per-instance data, after the Vertex attributes 0..4.
+// Shaders read them when compiled with k_InstancedDefine:
+//   layout (location = 5) in mat4 aInstanceModel;     // 5..8
+//   layout (location = 9) in mat3 aInstanceNormalMat; // 9..11
+const uint32_t k_InstanceModelLocation = 5;
+const uint32_t k_InstanceNormalMatLocation = 9;
+const char* const k_InstancedDefine = "INSTANCED";
+
+struct InstanceData {
+	glm::mat4 model;
+	glm::mat3 normalMat;
+};
+
+// Per-instance attribute buffer, drawing N copies of a VAO in one glDrawElementsInstanced.
+// attach() adds the instance attributes to a VAO once, later uploads only refill the
+// buffer, which grows as needed without detaching.
+class InstanceBuffer {
+	public:
+		explicit InstanceBuffer(const uint32_t capacity = 64);
+		InstanceBuffer(const InstanceBuffer&) = delete;
+		InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+		~InstanceBuffer();
+
+		// Points locations 5..11 of VAO at this buffer with a divisor of 1
+		void attach(const uint32_t VAO) const;
+
+		// Orphans the previous contents, so the GPU can still read them while these go up
+		void upload(const InstanceData* instances, const uint32_t count);
+		// Derives the normal matrices on the CPU and uploads
+		void upload(const glm::mat4* models, const uint32_t count);
+
+		// Every instance of count GL_UNSIGNED_INT indices of an attached VAO
+		void draw(const uint32_t VAO, const uint32_t indexCount) const;
+
+		uint32_t size() const { return size_; }
+		uint32_t capacity() const { return capacity_; }
+
+	private:
+		uint32_t buffer_ = 0;
+		uint32_t capacity_;
+		uint32_t size_ = 0;
+		std::vector<InstanceData> staging_;
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef __LIGHT_UNIFORMS_H__
+#define __LIGHT_UNIFORMS_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "shader.h"
+#include "struct_buffer.h"
+
+// Uniform blocks of the lighting shaders:
+//
+// struct DirLight {
+//     vec3 direction;
+//     vec3 ambient;
+//     vec3 diffuse;
+//     vec3 specular;
+// };
+//
+// struct PointLight {
+//     vec3 position;
+//     vec3 ambient;
+//     vec3 diffuse;
+//     vec3 specular;
+//     float constant;
+//     float linear;
+//     float quadratic;
+// };
+//
+// layout (std140) uniform Lights {
+//     DirLight dirLight;
+//     int numPointLights;
+// #ifndef POINT_LIGHTS_TEXTURE_BUFFER
+//     PointLight pointLights[MAX_POINT_LIGHTS];
+// #endif
+// };
+// #ifdef POINT_LIGHTS_TEXTURE_BUFFER
+// uniform samplerBuffer pointLightTexels; // k_PointLightTexels texels per light
+// #endif
+//
+// layout (std140) uniform MaterialParams {
+//     float shininess;
+// };
+//
+// Shader binds the blocks and the pointLightTexels sampler at link time. The defines
+// come from LightUniforms::defines(). With the array in the block, shaders loop to the
+// compile-time MAX_POINT_LIGHTS and unused entries add no light. numPointLights bounds
+// the loop of the texture buffer variant only.
+const char* const k_LightsBlockName = "Lights";
+const uint32_t k_LightsBlockBinding = 1;
+const char* const k_MaterialBlockName = "MaterialParams";
+const uint32_t k_MaterialBlockBinding = 2;
+const char* const k_PointLightSamplerName = "pointLightTexels";
+const uint32_t k_PointLightTextureUnit = 15; // last of the 16 units GL 3.3 guarantees
+
+// CPU mirrors of the structs in std140 layout, a vec3 is padded to 16 bytes unless a
+// float follows it
+struct DirLight {
+	glm::vec3 direction;
+	float pad0;
+	glm::vec3 ambient;
+	float pad1;
+	glm::vec3 diffuse;
+	float pad2;
+	glm::vec3 specular;
+	float pad3;
+};
+
+struct PointLight {
+	glm::vec3 position;
+	float pad0;
+	glm::vec3 ambient;
+	float pad1;
+	glm::vec3 diffuse;
+	float pad2;
+	glm::vec3 specular;
+	float constant;
+	float linear;
+	float quadratic;
+	float pad3[2];
+};
+
+struct MaterialParams {
+	float shininess;
+	float pad[3];
+};
+
+// RGBA32F texels of one PointLight in the texture buffer
+const uint32_t k_PointLightTexels = sizeof(PointLight) / 16;
+
+// Buffers behind the Lights block. The point lights live in the block while
+// maxPointLights of them fit in GL_MAX_UNIFORM_BLOCK_SIZE, in a texture buffer beyond,
+// and the whole array is uploaded with one call either way. In the block the array is
+// always full, padded with lights without color.
+class LightUniforms {
+	public:
+		explicit LightUniforms(const uint32_t maxPointLights);
+		LightUniforms(const LightUniforms&) = delete;
+		LightUniforms& operator=(const LightUniforms&) = delete;
+
+		void setDirLight(const DirLight& light);
+		void setPointLights(const PointLight* lights, const uint32_t count);
+		// The block header and the point light array, rebinding both
+		void upload() const;
+
+		// The lighting shader variant matching the storage, for ShaderVariants::get()
+		ShaderDefines defines() const;
+
+		StructBuffer::Storage storage() const {
+			return pointLights_ ? StructBuffer::Storage::TextureBuffer : StructBuffer::Storage::UniformBlock;
+		}
+		uint32_t maxPointLights() const { return maxPointLights_; }
+
+	private:
+		struct Header {
+			DirLight dirLight;
+			int32_t numPointLights;
+			int32_t pad[3];
+		};
+
+		Header header_;
+		std::vector<PointLight> lights_;
+		uint32_t maxPointLights_;
+		std::unique_ptr<StructBuffer> block_;
+		std::unique_ptr<StructBuffer> pointLights_; // null while the lights fit in block_
+};
+
+#endif
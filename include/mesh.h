@@ -1,11 +1,14 @@
 #ifndef __MESH_H__
-#define __MESH_H_ 1
+#define __MESH_H__ 1
 
 #include <glm/glm.hpp>
+#include <memory>
 #include <string>
 #include <vector>
+#include "shader.h"
+#include "vertex_format.h"
 
-class Shader;
+class SharedTexture;
 
 struct Vertex {
 	glm::vec3 Position;
@@ -19,23 +22,112 @@ struct Texture {
 	uint32_t id;
 	std::string type;
 	std::string path;
+	std::shared_ptr<SharedTexture> handle; // keeps the cached GL texture alive
+};
+
+// One level of detail: a range of the mesh indices drawn over the shared vertices
+struct MeshLod {
+	uint32_t firstIndex;
+	uint32_t numIndices;
+	float error; // largest object-space deviation from the full resolution mesh
+};
+
+// CPU-side result of processing one imported mesh, before any GL upload
+struct MeshData {
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices; // every level of detail, finest first
+	std::vector<Texture> textures;
+	std::vector<MeshLod> lods; // empty means a single level made of all indices
+};
+
+// Non-owning view of mesh geometry, e.g. a MeshData or a mapped cache entry
+struct MeshView {
+	const Vertex* vertices;
+	uint32_t numVertices;
+	const uint32_t* indices;
+	uint32_t numIndices;
+	std::vector<Texture> textures;
+	const MeshLod* lods;
+	uint32_t numLods;
+};
+
+MeshView viewOf(const MeshData& mesh);
+
+// CPU-side geometry a Mesh holds on to once it is on the GPU
+enum class CpuGeometry {
+	Keep, // vertices_ and indices_ with every level
+	Collision, // positions_ and the full resolution indices_ only
+	Discard // nothing, drawing only needs the GPU buffers
+};
+
+// Where a mesh lives inside vertex/index buffers shared by a whole Model
+struct MeshRange {
+	uint32_t VAO;
+	uint32_t baseVertex;
+	uint32_t firstIndex;
+	uint32_t indexSize; // bytes per index in the shared index buffer
 };
 
 class Mesh {
 	public:
 		Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices, std::vector<Texture> textures);
+		// Uploads straight from external memory (e.g. a mapped mesh cache), copying only what cpu keeps
+		explicit Mesh(const MeshView& view, const VertexFormat format = VertexFormat::Full,
+			const CpuGeometry cpu = CpuGeometry::Keep);
+		// Uploads and then takes over the vectors of data instead of copying them
+		explicit Mesh(MeshData&& data, const VertexFormat format = VertexFormat::Full,
+			const CpuGeometry cpu = CpuGeometry::Keep);
+		// Refers to geometry already uploaded to shared buffers, creates no GL objects
+		Mesh(const MeshView& view, const MeshRange& range, const VertexFormat format = VertexFormat::Full,
+			const CpuGeometry cpu = CpuGeometry::Keep);
+		Mesh(MeshData&& data, const MeshRange& range, const VertexFormat format = VertexFormat::Full,
+			const CpuGeometry cpu = CpuGeometry::Keep);
+		
+		Mesh(const Mesh&) = delete;
+		Mesh& operator=(const Mesh&) = delete;
+		Mesh(Mesh&&) = default;
+		Mesh& operator=(Mesh&&) = default;
 		
 		void Draw(const Shader& shader) const;
 		
+		// Binds the textures and, for packed formats, sets the positionScale/positionBias decode uniforms
+		void bind(const Shader& shader) const;
+		void drawElements(const uint32_t lod = 0) const; // expects VAO_ to be bound
+		
+		// Coarsest level whose error stays within maxError object-space units. Only moves to a
+		// coarser level than current once its error is below maxError * (1 - hysteresis),
+		// so meshes near the threshold do not pop back and forth.
+		uint32_t selectLod(const float maxError, const uint32_t current, const float hysteresis) const;
+		
+		// Drops CPU geometry down to what cpu keeps (never brings any back)
+		void releaseCpuGeometry(const CpuGeometry cpu);
+		size_t cpuBytes() const; // resident CPU geometry
+		
 		std::vector<Vertex> vertices_;
 		std::vector<uint32_t> indices_;
+		std::vector<glm::vec3> positions_; // CpuGeometry::Collision only
 		std::vector<Texture> textures_;
+		std::vector<UniformName> samplers_; // sampler uniform of each texture, e.g. texture_diffuse1
+		std::vector<MeshLod> lods_; // at least the full resolution level
+		glm::vec3 boundsMin_ = glm::vec3(0.0f); // AABB in object space
+		glm::vec3 boundsMax_ = glm::vec3(0.0f);
+		glm::vec3 boundsCenter_ = glm::vec3(0.0f); // bounding sphere in object space, centered on the AABB
+		float boundsRadius_ = 0.0f;
 		
 		uint32_t VAO_;
+		uint32_t baseVertex_ = 0;
+		uint32_t firstIndex_ = 0;
+		uint32_t indexSize_ = sizeof(uint32_t); // 2 when the GPU indices are 16-bit
+		VertexFormat format_ = VertexFormat::Full;
+		PositionQuantization quantization_ = { glm::vec3(1.0f), glm::vec3(0.0f) };
 	private:
-		void setupMesh();
+		void setupView(const MeshView& view);
+		void keepCpuGeometry(const MeshView& view, const CpuGeometry cpu);
+		void takeCpuGeometry(MeshData&& data, const CpuGeometry cpu);
+		void setupMesh(const Vertex* vertices, const uint32_t numVertices,
+			const uint32_t* indices, const uint32_t numIndices);
 		
-		uint32_t VBO_, EBO_;
+		uint32_t VBO_ = 0, EBO_ = 0;
 };
 
 #endif
@@ -0,0 +1,66 @@
+#ifndef __MESH_CACHE_H__
+#define __MESH_CACHE_H__ 1
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mesh.h"
+#include "scene_graph.h"
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		bool open(const std::string& path);
+		void close();
+
+		const uint8_t* data() const { return data_; }
+		size_t size() const { return size_; }
+
+	private:
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0;
+#ifdef _WIN32
+		void* file_ = nullptr;
+		void* mapping_ = nullptr;
+#endif
+};
+
+// Versioned on-disk cache of processed meshes. The file stores the final
+// interleaved Vertex/index arrays, the LOD table and the material texture table
+// of every mesh, then the node hierarchy, keyed by the source file hash and the
+// Assimp import flags.
+class MeshCache {
+	public:
+		// 2: meshes are welded and reordered on import, 3: LOD table, 4: node hierarchy
+		static const uint32_t k_Version = 4;
+
+		MeshCache(const std::string& sourcePath, const uint32_t importFlags);
+
+		// Maps the cache file and validates it against the source. Returns false on a miss.
+		bool load();
+		// Writes the cache file for the processed meshes and the nodes drawing them
+		bool write(const std::vector<MeshData>& meshes, const SceneGraph& scene) const;
+
+		uint32_t meshCount() const;
+		// Pointers into the mapping, textures only carry type and path
+		MeshView mesh(const uint32_t index) const;
+		// Rebuilds the node hierarchy, world matrices up to date
+		void scene(SceneGraph* scene) const;
+
+		const std::string& cachePath() const { return cachePath_; }
+
+	private:
+		std::string sourcePath_;
+		std::string cachePath_;
+		uint32_t importFlags_;
+		uint64_t sourceHash_ = 0;
+
+		MappedFile file_;
+};
+
+#endif
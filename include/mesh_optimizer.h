@@ -0,0 +1,41 @@
+#ifndef __MESH_OPTIMIZER_H__
+#define __MESH_OPTIMIZER_H__ 1
+
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+
+// Post-transform vertex cache efficiency of an index buffer, measured on a simulated FIFO cache
+struct VertexCacheStats {
+	float acmr; // average cache miss ratio: vertex shader invocations per triangle (0.5 - 3)
+	float atvr; // average transformed vertex ratio: invocations per referenced vertex (1 is optimal)
+};
+
+// What the import optimization did to one mesh
+struct MeshOptimizationStats {
+	uint32_t verticesBefore;
+	uint32_t verticesAfter;
+	uint32_t numTriangles;
+	uint32_t indexSize; // bytes per index on the GPU
+	VertexCacheStats before;
+	VertexCacheStats after;
+};
+
+VertexCacheStats analyzeVertexCache(const uint32_t* indices, const size_t numIndices,
+	const size_t numVertices, const uint32_t cacheSize = 16);
+
+// Merges bit-identical vertices and rewrites the indices to match
+void weldVertices(MeshData& mesh);
+// Reorders triangles for post-transform cache locality (Forsyth's linear-speed algorithm)
+void optimizeVertexCache(uint32_t* indices, const size_t numIndices, const size_t numVertices);
+// Reorders clusters of a cache-optimized index buffer so outward-facing ones are drawn first.
+// Keeps the input order if the cache miss ratio would grow by more than threshold.
+void optimizeOverdraw(uint32_t* indices, const size_t numIndices, const Vertex* vertices,
+	const size_t numVertices, const float threshold = 1.05f);
+// Renumbers vertices in first-use order so vertex fetches walk memory linearly. Drops unused vertices.
+void optimizeVertexFetch(MeshData& mesh);
+
+// Every stage above, in order. Stats may be null.
+void optimizeMesh(MeshData& mesh, MeshOptimizationStats* stats);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef __MESH_SIMPLIFIER_H__
+#define __MESH_SIMPLIFIER_H__ 1
+
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+
+const uint32_t k_MaxLods = 4; // including the full resolution level
+
+// Quadric error edge collapse. Collapses vertices onto their neighbours until the triangle
+// list reaches targetIndices (or nothing else can go), so the result indexes the same vertex
+// array. Vertices on open edges, which include UV and normal seams, never move.
+// error receives the largest object-space deviation introduced, may be null.
+std::vector<uint32_t> simplifyIndices(const Vertex* vertices, const size_t numVertices,
+	const uint32_t* indices, const size_t numIndices, const size_t targetIndices, float* error);
+
+// Appends coarser levels to the mesh indices, halving the triangle count each time,
+// and fills mesh.lods. Stops early once a level no longer shrinks noticeably.
+void generateLods(MeshData& mesh, const uint32_t maxLods = k_MaxLods);
+
+#endif
@@ -1,33 +1,164 @@
 #ifndef __MODEL_H__
-#define __MODEL_H_ 1
+#define __MODEL_H__ 1
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include "mesh.h"
+#include "frustum_cull.h"
+#include "indirect_draw.h"
+#include "mesh_optimizer.h"
+#include "render_queue.h"
+#include "scene_graph.h"
+#include "texture_cache.h"
+#include "texture_loader.h"
 #include "assimp/material.h"
 
 class aiNode;
 struct aiScene;
 class aiMesh;
 class aiMaterial;
+class Camera;
+class MeshCache;
+struct AsyncModelLoad;
+
+// How the meshes of a Model store their geometry on the GPU
+enum class StorageMode {
+	PerMesh, // one VAO/VBO/EBO per mesh
+	Consolidated // every mesh in one VBO/EBO behind a single VAO
+};
+
+struct ModelOptions {
+	bool gamma = false;
+	StorageMode storage = StorageMode::PerMesh;
+	VertexFormat vertexFormat = VertexFormat::Full; // packed formats need shaders that decode them
+	CpuGeometry cpuGeometry = CpuGeometry::Keep; // what the meshes keep once uploaded
+	// Consolidated only: Draw submits every mesh through an IndirectDrawList. Ignored unless
+	// the nodes draw each mesh once without a transform, the draw list has no per-draw matrices.
+	bool indirect = false;
+};
+
+// Where the time of a Model load went, in milliseconds. GL calls return before the driver
+// is done, so upload and mipmap times measure submission only.
+struct ModelLoadStats {
+	bool cacheHit = false;
+	double totalMs = 0.0;
+	double cacheReadMs = 0.0; // mapping and validating the mesh cache
+	double parseMs = 0.0; // Assimp ReadFile
+	double traverseMs = 0.0; // processNode, without the processMesh calls
+	double convertMs = 0.0; // processMesh vertex and index conversion
+	double optimizeMs = 0.0; // welding and reordering
+	double lodMs = 0.0; // LOD generation
+	double cacheWriteMs = 0.0;
+	double textureDecodeMs = 0.0; // summed over the worker threads
+	double textureUploadMs = 0.0; // including mipmapMs
+	double mipmapMs = 0.0;
+	double meshUploadMs = 0.0; // vertex packing and buffer uploads
+	uint32_t meshes = 0;
+	uint32_t vertices = 0;
+	uint32_t indices = 0; // every level of detail
+	uint32_t texturesDecoded = 0;
+	uint32_t texturesShared = 0; // already resident in the TextureCache
+	uint64_t vertexBytes = 0; // GPU buffer sizes
+	uint64_t indexBytes = 0;
+
+	void add(const ModelLoadStats& other);
+	std::string toJson() const;
+};
+
+// Level of detail selection of Model::Draw
+struct LodSettings {
+	float viewportHeight = 720.0f; // pixels
+	float pixelError = 1.0f; // largest deviation from the full mesh allowed on screen
+	float hysteresis = 0.25f; // margin below pixelError before switching to a coarser level
+};
+
+// Level drawn for each node mesh of one instance, kept between frames by the caller
+struct LodState {
+	std::vector<uint32_t> levels;
+};
 
 class Model {
 	public:
 		std::vector<Texture> textures_loaded_;
+		std::vector<TextureTiming> textureTimings_; // decode vs upload time of each loaded texture
+		ModelLoadStats loadStats_;
+		std::vector<MeshOptimizationStats> optimizationStats_; // per mesh, only filled when importing (cache miss)
 		std::vector<Mesh> meshes_;
+		SceneGraph scene_; // aiNode hierarchy, call scene_.update() after moving nodes
 		std::string directory_;
 		bool gammaCorrection_;
 		
 		Model(std::string const &path, bool gamma = false);
+		Model(std::string const &path, const ModelOptions& options);
+		// Model from meshes built in memory, textures are used as given
+		explicit Model(const std::vector<MeshData>& meshes, const ModelOptions& options = ModelOptions());
+		Model(const Model&) = delete;
+		Model& operator=(const Model&) = delete;
+		~Model();
+		
+		// Starts importing on the worker pool and returns at once. Meshes become
+		// drawable as update() uploads them, so Draw renders whatever is resident.
+		// Consolidated models only become drawable once every mesh has arrived.
+		static std::shared_ptr<Model> loadAsync(std::string const &path, bool gamma = false);
+		static std::shared_ptr<Model> loadAsync(std::string const &path, const ModelOptions& options);
+		// Uploads up to maxMeshes streamed meshes (GL thread). Returns true while loading.
+		bool update(const uint32_t maxMeshes = 1);
+		bool isLoaded() const;
 		
+		// Drops CPU geometry of every mesh down to what cpu keeps
+		void releaseCpuGeometry(const CpuGeometry cpu);
+		size_t cpuBytes() const; // resident CPU geometry of the meshes
+		
+		// Every node mesh without node transforms, the shader's model uniform is up to the caller.
+		// A mesh referenced by several nodes is drawn once per node.
 		void Draw(const Shader& shader) const;
+		// Every node's meshes with model * world of the node in the model uniform, and in
+		// normalMat when the program has it
+		void Draw(const Shader& shader, const glm::mat4& model) const;
+		// Draws each node mesh like Draw(shader, model), at the coarsest level whose
+		// projected error stays under settings.pixelError
+		void Draw(const Shader& shader, const Camera& camera, const glm::mat4& model,
+			const LodSettings& settings, LodState* state = nullptr) const;
+		// Records one packet per node mesh placed by model * world of the node, drawn in key
+		// order by queue.submit(). With a frustum, meshes whose world bounds are outside it are left out,
+		// culled in scratch owned by the model, so one model records into one queue at a time.
+		void enqueue(RenderQueue& queue, const Shader& shader, const glm::mat4& model,
+			const RenderPass pass = RenderPass::Opaque, const Frustum* frustum = nullptr) const;
 	
 	private:
+		Model() = default;
+		
 		void loadModel(std::string const path);
 		
-		void processNode(aiNode *node, const aiScene *scene);
-		Mesh processMesh(aiMesh *mesh, const aiScene *scene);
+		void loadFromCache(const MeshCache& cache);
+		// Meshes take over the vectors of owned (same order as views) instead of copying
+		void createMeshes(const std::vector<MeshView>& views, std::vector<MeshData>* owned = nullptr);
+		void countMesh(const Mesh& mesh, const uint32_t numVertices, const uint32_t numIndices);
+		static bool importMeshes(std::string const &path, const MeshCache& cache, std::vector<MeshData>* meshes,
+			SceneGraph* nodes, std::vector<MeshOptimizationStats>* stats, ModelLoadStats* loadStats);
+		
+		// Converts each aiMesh once, at its first reference. converted maps aiMesh to mesh index.
+		static void processNode(aiNode *node, const aiScene *scene, const int32_t parent, std::vector<MeshData>* meshes,
+			SceneGraph* nodes, std::vector<int32_t>* converted, ModelLoadStats* loadStats);
+		static MeshData processMesh(aiMesh *mesh, const aiScene *scene);
 	
-		std::vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName);
+		static std::vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName);
+		// Resolves textures through the global TextureCache, decoding the missing ones in parallel
+		void loadTextures(const std::vector<Texture*>& textures);
+		
+		ModelOptions options_;
+		uint32_t VAO_ = 0, VBO_ = 0, EBO_ = 0; // shared buffers of a consolidated model
+		
+		std::unique_ptr<IndirectDrawList> indirect_; // draws from the shared buffers, deleted with them
+		std::shared_ptr<AsyncModelLoad> async_; // set while an asynchronous load is in progress
+		std::unordered_map<std::string, TextureHandle> streamedTextures_;
+		std::vector<MeshData> streamedMeshes_;
+
+		// Culling scratch of enqueue(), kept between calls
+		mutable CullBounds cullBounds_;
+		mutable std::vector<uint32_t> cullResident_; // draw of each bound
+		mutable std::vector<uint32_t> cullVisible_;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef __OCCLUSION_CULLER_H__
+#define __OCCLUSION_CULLER_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class CullBounds;
+class Mesh;
+class Model;
+class ThreadPool;
+
+struct OcclusionStats {
+	uint32_t occluders = 0;
+	uint32_t triangles = 0; // occluder triangles submitted
+	uint32_t trianglesRasterized = 0; // left after near clipping and dropping the ones without area
+	uint32_t tested = 0; // occludee boxes
+	uint32_t culled = 0; // found hidden
+	double setupMs = 0.0; // transform, clipping and edge setup
+	double rasterMs = 0.0;
+	double hizMs = 0.0;
+	double testMs = 0.0;
+};
+
+// Software occlusion culling on the CPU. Occluders are rasterized into a small depth
+// buffer, split in horizontal bands that render in parallel with SSE (4 pixels per
+// step). A hierarchical-Z pyramid keeps the farthest depth of every 2x2 block of the
+// level below, so a box is tested against at most 3x3 texels of the level where its
+// screen rectangle spans about two. A box is hidden when its nearest point is behind
+// the farthest occluder depth over its whole rectangle.
+//
+// Per frame:
+//   culler.begin(viewProj);
+//   culler.addOccluder(floor, model); ...   // large, simple meshes
+//   culler.rasterize();
+//   culler.cull(bounds, frustumVisible, &visible);
+//
+// Occluders cover a pixel when its center is inside, so their silhouettes are exact to
+// half a pixel; anything hidden by less than that may be culled.
+class OcclusionCuller {
+	public:
+		// width is rounded up to a multiple of 4. threads 0 = one per hardware thread.
+		explicit OcclusionCuller(const uint32_t width = 256, const uint32_t height = 128, const uint32_t threads = 0);
+		OcclusionCuller(const OcclusionCuller&) = delete;
+		OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+		~OcclusionCuller();
+
+		// Clears the depth buffer and the occluders of the previous frame
+		void begin(const glm::mat4& viewProj);
+
+		// Indexed triangles placed by model, both faces occlude
+		void addOccluder(const glm::vec3* positions, const uint32_t numVertices, const uint32_t* indices,
+			const uint32_t numIndices, const glm::mat4& model);
+		// Full resolution level of a mesh that kept its CPU geometry (Keep or Collision)
+		void addOccluder(const Mesh& mesh, const glm::mat4& model);
+		// Every node mesh of a model, placed by model * world of the node
+		void addOccluder(const Model& object, const glm::mat4& model);
+
+		// Renders the occluders and builds the pyramid
+		void rasterize();
+
+		// World AABB against the pyramid, false when hidden or off screen
+		bool isVisible(const glm::vec3& center, const glm::vec3& extents) const;
+		// Appends to visible the candidates of bounds that are not hidden, in order
+		void cull(const CullBounds& bounds, const std::vector<uint32_t>& candidates, std::vector<uint32_t>* visible);
+
+		// With SIMD off the bands rasterize one pixel at a time, for comparisons
+		void setSimd(const bool enabled) { simd_ = enabled; }
+
+		uint32_t width() const { return width_; }
+		uint32_t height() const { return height_; }
+		// Level 0 is the depth buffer, depth in [0, 1] with 1 cleared, rows bottom up
+		uint32_t levels() const { return static_cast<uint32_t>(levels_.size()); }
+		const float* depth(const uint32_t level = 0) const { return &pyramid_[levels_[level].offset]; }
+		const OcclusionStats& stats() const { return stats_; }
+
+	private:
+		// Screen space triangle: edge functions a * x + b * y + c >= 0 inside, depth plane
+		struct Triangle {
+			float edgeA[3], edgeB[3], edgeC[3];
+			float depthA, depthB, depthC;
+			int32_t minX, maxX, minY, maxY; // pixels, inclusive
+		};
+		struct Level {
+			uint32_t width, height;
+			size_t offset; // in pyramid_
+		};
+
+		void setupTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+		void rasterizeBand(const int32_t firstRow, const int32_t endRow);
+		void buildPyramid();
+
+		uint32_t width_, height_;
+		glm::mat4 viewProj_ = glm::mat4(1.0f);
+		std::vector<float> pyramid_; // every level, level 0 first
+		std::vector<Level> levels_;
+		std::vector<Triangle> triangles_;
+		std::vector<glm::vec4> clip_; // scratch, clip space occluder vertices
+		std::unique_ptr<ThreadPool> pool_;
+		bool simd_ = true;
+		OcclusionStats stats_;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef __RENDER_QUEUE_H__
+#define __RENDER_QUEUE_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Mesh;
+class Shader;
+
+enum class RenderPass : uint8_t {
+	Opaque, // front to back, blending off
+	Blended // back to front after every opaque draw, alpha blending on and depth writes off
+};
+
+// One draw recorded for later submission. Either a Mesh (textures and VAO of its own)
+// or raw indexed triangles of a VAO with up to k_MaxTextures 2D textures on units 0..n-1.
+struct DrawPacket {
+	static const uint32_t k_MaxTextures = 4;
+
+	const Shader* shader;
+	const Mesh* mesh; // null for raw geometry
+	uint32_t lod; // mesh level of detail
+	uint32_t VAO;
+	uint32_t count; // raw geometry indices
+	uint32_t numTextures;
+	uint32_t textures[k_MaxTextures];
+	glm::mat4 model;
+};
+
+struct RenderQueueStats {
+	uint32_t packets = 0;
+	uint32_t programChanges = 0; // between consecutive packets in submission order
+	uint32_t materialChanges = 0;
+	uint32_t VAOChanges = 0;
+	double sortMs = 0.0;
+	double submitMs = 0.0;
+};
+
+// Collects the draws of a frame and submits them ordered by a 64-bit sort key, so
+// programs, texture sets and VAOs change as rarely as possible. From the most
+// significant bit:
+//   opaque:  pass (2) | program (12) | material (16) | VAO (10) | depth (24), front to back
+//   blended: pass (2) | depth (24), back to front | program (12) | material (16) | VAO (10)
+// The material is a hash of the bound textures. Fields are truncated, a collision only
+// costs an extra state change. The model matrix goes to the "model" uniform and, when
+// the program has it, its normal matrix to "normalMat"; everything else shared by the
+// frame (view, projection, lights) is set on the programs before submit().
+class RenderQueue {
+	public:
+		// Clears the queue. depth is the view-space distance, mapped over [zNear, zFar].
+		void begin(const glm::mat4& view, const float zNear, const float zFar);
+
+		void enqueue(const Shader& shader, const Mesh& mesh, const glm::mat4& model,
+			const RenderPass pass = RenderPass::Opaque, const uint32_t lod = 0);
+		// Indexed GL_TRIANGLES with GL_UNSIGNED_INT indices, depth taken at the model origin
+		void enqueue(const Shader& shader, const uint32_t VAO, const uint32_t count, const glm::mat4& model,
+			const RenderPass pass = RenderPass::Opaque, const uint32_t* textures = nullptr, const uint32_t numTextures = 0);
+
+		// Radix-sorts the keys, submit() does it when needed
+		void sort();
+		// Draws every packet in key order through GLState and leaves blending off and depth writes on
+		void submit();
+
+		// With sorting off packets are submitted in the order they were enqueued, for comparisons
+		void setSorting(const bool enabled) { sorting_ = enabled; }
+
+		size_t size() const { return packets_.size(); }
+		const RenderQueueStats& stats() const { return stats_; }
+
+		static uint64_t makeKey(const RenderPass pass, const uint32_t program, const uint32_t material,
+			const uint32_t VAO, const float depth);
+
+	private:
+		struct SortEntry {
+			uint64_t key;
+			uint32_t packet;
+		};
+
+		void push(const DrawPacket& packet, const RenderPass pass, const uint32_t material, const glm::vec3& center);
+		float depthOf(const glm::vec3& center) const;
+
+		glm::mat4 view_ = glm::mat4(1.0f);
+		float zNear_ = 0.1f;
+		float zFar_ = 100.0f;
+		bool sorting_ = true;
+		bool sorted_ = false;
+
+		std::vector<DrawPacket> packets_;
+		std::vector<SortEntry> entries_;
+		std::vector<SortEntry> scratch_; // radix sort ping-pong buffer
+		RenderQueueStats stats_;
+};
+
+#endif
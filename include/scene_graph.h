@@ -0,0 +1,59 @@
+#ifndef __SCENE_GRAPH_H__
+#define __SCENE_GRAPH_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A mesh drawn at a node, one per aiNode mesh reference
+struct SceneDraw {
+	uint32_t node;
+	uint32_t mesh; // index into Model::meshes_
+};
+
+// Node hierarchy of a Model in flat arrays, indexed by node. Nodes are stored depth first,
+// every parent before its children and every subtree in one contiguous range, so world
+// matrices are computed in a single forward pass and a changed node only touches
+// [node, subtreeEnd(node)). World matrices are relative to the model root, the caller
+// places the whole model on top of them.
+class SceneGraph {
+	public:
+		static const int32_t k_NoParent = -1;
+
+		void clear();
+		// Appends a node, parent must be the last node added or one of its ancestors
+		// (depth first order). Returns the node index.
+		uint32_t addNode(const std::string& name, const int32_t parent, const glm::mat4& local);
+		void addDraw(const uint32_t node, const uint32_t mesh);
+
+		uint32_t size() const { return static_cast<uint32_t>(parents_.size()); }
+		bool empty() const { return parents_.empty(); }
+		// First node called name, k_NoParent when there is none
+		int32_t find(const std::string& name) const;
+
+		const std::string& name(const uint32_t node) const { return names_[node]; }
+		int32_t parent(const uint32_t node) const { return parents_[node]; }
+		uint32_t subtreeEnd(const uint32_t node) const { return subtreeEnds_[node]; }
+		const glm::mat4& local(const uint32_t node) const { return locals_[node]; }
+		// Up to date after update()
+		const glm::mat4& world(const uint32_t node) const { return worlds_[node]; }
+		const std::vector<SceneDraw>& draws() const { return draws_; }
+
+		// Marks the subtree of node for update()
+		void setLocal(const uint32_t node, const glm::mat4& local);
+		// Recomputes the world matrices of the changed subtrees, returns how many nodes it touched
+		uint32_t update();
+
+	private:
+		std::vector<int32_t> parents_;
+		std::vector<uint32_t> subtreeEnds_; // one past the last descendant
+		std::vector<glm::mat4> locals_;
+		std::vector<glm::mat4> worlds_;
+		std::vector<uint8_t> dirty_;
+		std::vector<std::string> names_; // cold, only for find()
+		std::vector<SceneDraw> draws_;
+		uint32_t firstDirty_ = 0; // no dirty node before it, size() when clean
+};
+
+#endif
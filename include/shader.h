@@ -1,10 +1,70 @@
 #ifndef __SHADER_H__
-#define __SHADER_H_ 1
+#define __SHADER_H__ 1
 
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+// 32-bit FNV-1a of a uniform name, usable at compile time
+constexpr uint32_t uniformHash(const char* name, const uint32_t hash = 2166136261u) {
+	return *name ? uniformHash(name + 1, (hash ^ static_cast<uint8_t>(*name)) * 16777619u) : hash;
+}
+
+// Uniform name hashed once, e.g. static const UniformName k_Model("model"). Only the
+// pointer is kept, so text must outlive it (a string literal or an interned string).
+struct UniformName {
+	uint32_t hash;
+	const char* name;
+	constexpr explicit UniformName(const char* text) : hash(uniformHash(text)), name(text) {}
+};
+
+// Slot of an active uniform in a Shader's reflection table, -1 if the program doesn't use it
+struct UniformHandle {
+	int32_t slot = -1;
+};
+
+// Uploads issued vs skipped because the program already held the value
+struct UniformStats {
+	uint64_t issued = 0;
+	uint64_t skipped = 0;
+};
+
+// Programs taken from the on-disk binary cache vs compiled from source
+struct ProgramCacheStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t rejected = 0; // binaries found but refused by the driver, then recompiled
+	double loadMs = 0.0; // spent creating programs from cached binaries
+	double compileMs = 0.0; // spent compiling and linking from source
+	uint64_t stagesCompiled = 0;
+	uint64_t stagesShared = 0; // stage objects reused from another program
+};
+
+// Blocking checks the program before the constructor returns. Deferred returns once
+// the compile and link are submitted and waits only when the program is first needed.
+enum class ShaderCompile {
+	Blocking,
+	Deferred
+};
+
+// Preprocessor define injected into every stage, the value may be empty
+struct ShaderDefine {
+	std::string name;
+	std::string value;
+};
+
+typedef std::vector<ShaderDefine> ShaderDefines;
+
+struct ShaderDesc {
+	std::string vertexPath;
+	std::string fragmentPath;
+	std::string geometryPath; // empty without a geometry stage
+	ShaderDefines defines;
+};
+
 class Shader {
 	enum class Type
 	{
@@ -17,9 +77,49 @@ class Shader {
 public:
 	Shader() = delete;
 	Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
+	Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath, const ShaderCompile mode);
+	// The defines are inserted after the #version line of every stage, so the
+	// binary cache keys the program by its sources and its define set
+	explicit Shader(const ShaderDesc& desc, const ShaderCompile mode = ShaderCompile::Blocking);
 	~Shader();
 
+	// Submits every program before waiting on any of them, so the driver can compile them
+	// while the caller goes on loading textures and models
+	static std::vector<std::unique_ptr<Shader>> compileBatch(const std::vector<ShaderDesc>& programs);
+
+	// True once the program can be used without waiting. Polls the driver with
+	// KHR_parallel_shader_compile, without it this waits like finish().
+	bool ready() const;
+	// Waits for the compile and link, reports errors and reflects the uniforms.
+	// use(), uniform() and set() call it, so a deferred program blocks on first use at the latest.
+	void finish() const;
+
 	void use() const;
+	uint32_t id() const { return id_; } // GL program name
+
+	// Uniforms are looked up in a table reflected at link time, by hash and then by name,
+	// so a name the program doesn't have never resolves to one it has. Values are shadowed
+	// per program and re-setting the current value issues no GL call, so uniforms of this
+	// program must only be changed through set().
+	UniformHandle uniform(const char* name) const;
+	UniformHandle uniform(const UniformName name) const;
+
+	static const UniformStats& uniformStats();
+	static void resetUniformStats();
+
+	// Linked programs are cached in this directory, keyed by a hash of all stage sources
+	// and the driver's vendor, renderer and version strings. A binary the driver rejects
+	// falls back to a full compile. Empty disables the cache, default "shader_cache".
+	static void setProgramCacheDir(const std::string& dir);
+	static const std::string& programCacheDir();
+	static const ProgramCacheStats& programCacheStats();
+	static void resetProgramCacheStats();
+
+	// Identical stages (same type and source after define injection) are compiled once and
+	// attached to every program that uses them. The stage objects stay alive until
+	// clearStageCache(), which programs already linked don't depend on. On by default.
+	static void setStageSharing(const bool enabled);
+	static void clearStageCache();
 
 	void set(const char* name, const bool value) const;
 	void set(const char* name, const int value) const;
@@ -33,12 +133,108 @@ public:
 	void set(const char* name, const glm::mat2 &value) const;
 	void set(const char* name, const glm::mat3 &value) const;
 	void set(const char* name, const glm::mat4 &value) const;
+
+	void set(const UniformName name, const bool value) const { set(uniform(name), value); }
+	void set(const UniformName name, const int value) const { set(uniform(name), value); }
+	void set(const UniformName name, const float value) const { set(uniform(name), value); }
+	void set(const UniformName name, const glm::vec2 &value) const { set(uniform(name), value); }
+	void set(const UniformName name, const glm::vec3 &value) const { set(uniform(name), value); }
+	void set(const UniformName name, const glm::vec4 &value) const { set(uniform(name), value); }
+	void set(const UniformName name, const glm::mat2 &value) const { set(uniform(name), value); }
+	void set(const UniformName name, const glm::mat3 &value) const { set(uniform(name), value); }
+	void set(const UniformName name, const glm::mat4 &value) const { set(uniform(name), value); }
+
+	void set(const UniformHandle handle, const bool value) const;
+	void set(const UniformHandle handle, const int value) const;
+	void set(const UniformHandle handle, const float value) const;
+	void set(const UniformHandle handle, const glm::vec2 &value) const;
+	void set(const UniformHandle handle, const glm::vec3 &value) const;
+	void set(const UniformHandle handle, const glm::vec4 &value) const;
+	void set(const UniformHandle handle, const glm::mat2 &value) const;
+	void set(const UniformHandle handle, const glm::mat3 &value) const;
+	void set(const UniformHandle handle, const glm::mat4 &value) const;
 private:
-	void checkErrors(const uint32_t shader, const Type type) const;
+	// Active uniform and the last value uploaded to it
+	struct Uniform {
+		int32_t location;
+		uint32_t size = 0; // bytes of value in use, 0 until first set
+		uint8_t value[sizeof(glm::mat4)];
+	};
+
+	// Sources and stage objects of a program whose compile and link may still be running
+	struct Pending {
+		std::string sources[3];
+		uint32_t numSources = 0;
+		uint32_t shaders[3] = {};
+		uint64_t key = 0; // program binary cache key, 0 with the cache off
+		bool fromBinary = false;
+		bool ownsStages = true; // false while the stage cache holds them
+		double ms = 0.0; // spent submitting it
+	};
+
+	// Binds the shared uniform blocks (e.g. Frame) and builds the uniform table
+	void reflectUniforms() const;
+	// True when the value differs from the shadow copy, which is then updated
+	bool changed(const UniformHandle handle, const void* value, const uint32_t size) const;
+
+	// Queues the compile of every stage and the link of id_
+	void submit(Pending& pending) const;
+	bool loadBinary(const std::string& path, const uint64_t key) const;
+	void storeBinary(const std::string& path, const uint64_t key) const;
+
+	bool checkErrors(const uint32_t shader, const Type type) const;
 	void loadShader(const char* path, std::string* code) const;
 
 	std::vector<Shader> list_;
 	uint32_t id_;
+
+	mutable std::unique_ptr<Pending> pending_; // null once finished
+
+	// Reflected name behind a hash, several names can share one uniform (array and array[0])
+	struct Slot {
+		int32_t uniform; // index into uniforms_
+		std::string name;
+	};
+
+	mutable std::vector<Uniform> uniforms_;
+	mutable std::unordered_map<uint32_t, Slot> slots_; // name hash to uniform
+};
+
+// Specializations of one set of shader files. Every define set is compiled once and
+// reused, so features and loop counts are compiled out instead of being branched on
+// at runtime, e.g. variants.get({ { "NUMBER_POINT_LIGHTS", "4" } }).
+class ShaderVariants {
+public:
+	ShaderVariants(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
+	ShaderVariants(const ShaderVariants&) = delete;
+	ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+	// The program for these defines, in any order, compiled on the first request
+	const Shader& get(const ShaderDefines& defines, const ShaderCompile mode = ShaderCompile::Blocking);
+
+	size_t size() const { return variants_.size(); }
+private:
+	ShaderDesc desc_;
+	std::unordered_map<uint64_t, std::unique_ptr<Shader>> variants_; // define set hash to program
+};
+
+// Process-wide registry of programs. Asking again for the same files (by normalized
+// path) and defines returns the program already created instead of linking a duplicate.
+// A program is deleted with its last handle. GL thread only.
+class ShaderLibrary {
+public:
+	static ShaderLibrary& instance();
+
+	std::shared_ptr<const Shader> get(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
+	std::shared_ptr<const Shader> get(const ShaderDesc& desc, const ShaderCompile mode = ShaderCompile::Blocking);
+
+	uint64_t hits() const { return hits_; }
+	uint64_t misses() const { return misses_; }
+	size_t size() const; // programs still alive
+private:
+	std::unordered_map<uint64_t, std::weak_ptr<const Shader>> programs_;
+	uint64_t hits_ = 0;
+	uint64_t misses_ = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef __STREAM_BUFFER_H__
+#define __STREAM_BUFFER_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Uniform block of the per-object constants, streamed once per draw:
+//
+// layout (std140) uniform Object {
+//     mat4 model;
+//     mat3 normalMat;
+// };
+//
+// Shader binds it to k_ObjectBlockBinding at link time.
+const char* const k_ObjectBlockName = "Object";
+const uint32_t k_ObjectBlockBinding = 3;
+
+// CPU mirror of the Object block in std140 layout
+struct ObjectData {
+	glm::mat4 model;
+	glm::vec4 normalMat[3]; // std140 pads every mat3 column to 16 bytes
+};
+
+static_assert(sizeof(ObjectData) == 112, "Object block is 112 bytes in std140");
+
+ObjectData objectData(const glm::mat4& model);
+
+// Where an allocation went, data is null when the frame region is full
+struct StreamAllocation {
+	void* data;
+	size_t offset; // in the buffer, for bindRange()
+};
+
+struct StreamBufferStats {
+	uint64_t bytes = 0;
+	uint64_t overflows = 0; // allocations that did not fit
+	uint64_t waits = 0; // frames that found their region still in use by the GPU
+	double waitMs = 0.0;
+};
+
+// Buffer for data written once per frame. Allocations are bump-pointer sub-ranges of the
+// current frame region, aligned for binding by offset.
+//   Persistent: GL 4.4 / ARB_buffer_storage. One buffer of frames regions stays mapped;
+//   a fence at the end of each frame guards its region until the GPU is done with it.
+//   Orphaning: a frame sized buffer re-specified at the start of every frame, writes go
+//   to a CPU copy and flush() uploads them.
+class StreamBuffer {
+	public:
+		enum class Mode {
+			Persistent,
+			Orphaning
+		};
+
+		// target e.g. GL_UNIFORM_BUFFER. Persistent falls back to Orphaning without buffer storage.
+		StreamBuffer(const uint32_t target, const size_t frameBytes, const uint32_t frames = 3,
+			const Mode mode = Mode::Persistent);
+		StreamBuffer(const StreamBuffer&) = delete;
+		StreamBuffer& operator=(const StreamBuffer&) = delete;
+		~StreamBuffer();
+
+		// Moves to the next frame region, waiting for its fence if the GPU still reads it
+		void beginFrame();
+		StreamAllocation allocate(const size_t bytes);
+		template<typename T>
+		StreamAllocation push(const T& value) {
+			const StreamAllocation allocation = allocate(sizeof(T));
+			if (allocation.data) *static_cast<T*>(allocation.data) = value;
+			return allocation;
+		}
+		// Makes the allocations since the last flush visible to GL. Call it after writing
+		// and before the draws that read them. Nothing to do for a coherent persistent mapping.
+		void flush();
+		// Fences the frame region behind the draws issued so far
+		void endFrame();
+
+		// glBindBufferRange of an allocation on an indexed target (uniform buffers)
+		void bindRange(const uint32_t binding, const size_t offset, const size_t bytes) const;
+
+		Mode mode() const { return mode_; }
+		size_t alignment() const { return alignment_; }
+		const StreamBufferStats& stats() const { return stats_; }
+		void resetStats() { stats_ = StreamBufferStats(); }
+
+	private:
+		uint32_t target_;
+		size_t frameBytes_;
+		uint32_t frames_;
+		Mode mode_;
+		size_t alignment_ = 16;
+
+		uint32_t buffer_ = 0;
+		uint8_t* mapped_ = nullptr; // Persistent
+		std::vector<uint8_t> staging_; // Orphaning
+		std::vector<void*> fences_; // GLsync of every region, null once waited for
+
+		uint32_t frame_;
+		size_t head_ = 0;
+		size_t end_ = 0;
+		size_t flushed_ = 0;
+		StreamBufferStats stats_;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __STRUCT_BUFFER_H__
+#define __STRUCT_BUFFER_H__ 1
+
+#include <cstddef>
+#include <cstdint>
+
+// GPU array of std140 structs, read through a uniform block bound to a binding point
+// or through a samplerBuffer (RGBA32F texels) bound to a texture unit. Either way the
+// whole array goes up in one call instead of one glUniform per field.
+class StructBuffer {
+	public:
+		enum class Storage {
+			UniformBlock,
+			TextureBuffer
+		};
+
+		StructBuffer(const Storage storage, const uint32_t binding, const size_t capacity);
+		StructBuffer(const StructBuffer&) = delete;
+		StructBuffer& operator=(const StructBuffer&) = delete;
+		~StructBuffer();
+
+		// One glBufferSubData at the byte offset, which must stay within the capacity
+		void uploadBytes(const void* data, const size_t bytes, const size_t offset = 0) const;
+
+		template<typename T>
+		void upload(const T* items, const uint32_t count, const size_t offset = 0) const {
+			static_assert(sizeof(T) % 16 == 0, "std140 array elements and RGBA32F texels are 16 byte multiples");
+			uploadBytes(items, count * sizeof(T), offset);
+		}
+
+		// Binds the block to its binding point, or the texture to its texture unit
+		void bind() const;
+
+		Storage storage() const { return storage_; }
+		size_t capacity() const { return capacity_; }
+
+		// GL_MAX_UNIFORM_BLOCK_SIZE, at least 16 KB
+		static size_t maxUniformBlockSize();
+
+	private:
+		Storage storage_;
+		uint32_t binding_;
+		size_t capacity_;
+		uint32_t buffer_ = 0;
+		uint32_t texture_ = 0; // texture buffer view of buffer_
+};
+
+#endif
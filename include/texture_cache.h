@@ -0,0 +1,80 @@
+#ifndef __TEXTURE_CACHE_H__
+#define __TEXTURE_CACHE_H__ 1
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct DecodedImage;
+
+// GL texture shared through the TextureCache. The GL texture is deleted
+// together with the last handle, so handles must be released on the GL thread.
+class SharedTexture {
+	public:
+		SharedTexture(const uint32_t id, const size_t bytes, const uint64_t contentHash);
+		SharedTexture(const SharedTexture&) = delete;
+		SharedTexture& operator=(const SharedTexture&) = delete;
+		~SharedTexture();
+
+		uint32_t id() const { return id_; }
+		size_t bytes() const { return bytes_; }
+
+	private:
+		friend class TextureCache;
+
+		uint32_t id_;
+		size_t bytes_;
+		uint64_t contentHash_;
+		std::vector<std::string> keys_; // every path resolving to this texture
+};
+
+typedef std::shared_ptr<SharedTexture> TextureHandle;
+
+struct TextureCacheStats {
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t residentBytes;
+	uint32_t residentTextures;
+};
+
+// Process-wide texture cache keyed by normalized absolute path. With content
+// hashing enabled, identical images found under different paths share one texture.
+class TextureCache {
+	public:
+		static TextureCache& instance();
+		static std::string normalizePath(const std::string& path);
+
+		// Looks up a resident texture, counting a hit or a miss
+		TextureHandle find(const std::string& path);
+		// Uploads a decoded image (GL thread) and registers it under the path.
+		// Returns the already resident texture if another load got there first.
+		TextureHandle insert(const std::string& path, DecodedImage& image, double* uploadMs = nullptr,
+			double* mipmapMs = nullptr);
+
+		void setContentHashing(const bool enabled) { contentHashing_ = enabled; }
+		bool contentHashing() const { return contentHashing_; }
+
+		TextureCacheStats stats() const;
+
+	private:
+		friend class SharedTexture;
+
+		TextureCache() = default;
+		void release(SharedTexture* texture);
+
+		mutable std::mutex mutex_;
+		std::unordered_map<std::string, std::weak_ptr<SharedTexture>> byPath_;
+		std::unordered_map<uint64_t, std::weak_ptr<SharedTexture>> byContent_;
+
+		std::atomic<bool> contentHashing_{ false };
+		std::atomic<uint64_t> hits_{ 0 };
+		std::atomic<uint64_t> misses_{ 0 };
+		std::atomic<uint64_t> residentBytes_{ 0 };
+		std::atomic<uint32_t> residentTextures_{ 0 };
+};
+
+#endif
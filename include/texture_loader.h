@@ -0,0 +1,36 @@
+#ifndef __TEXTURE_LOADER_H__
+#define __TEXTURE_LOADER_H__ 1
+
+#include <cstdint>
+#include <string>
+
+// Image decoded on the CPU, waiting for its GL upload
+struct DecodedImage {
+	std::string path;
+	int32_t width = 0;
+	int32_t height = 0;
+	int32_t components = 0;
+	uint8_t* pixels = nullptr; // owned, released by uploadTexture
+	uint64_t contentHash = 0; // only computed on request
+	double decodeMs = 0.0;
+};
+
+// Time spent on each half of a texture load
+struct TextureTiming {
+	std::string path;
+	double decodeMs;
+	double uploadMs;
+	double mipmapMs; // part of uploadMs
+};
+
+// Decodes an image file, optionally hashing its pixels. Safe to call from any thread.
+DecodedImage decodeImage(const std::string& path, const bool hashContent = false);
+
+// Creates the GL texture (with mipmaps) and frees the pixels. GL context thread only.
+// mipmapMs receives the glGenerateMipmap part of uploadMs.
+uint32_t uploadTexture(DecodedImage& image, double* uploadMs = nullptr, double* mipmapMs = nullptr);
+
+// Frees the pixels of an image that won't be uploaded
+void releaseImage(DecodedImage& image);
+
+#endif
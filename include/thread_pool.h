@@ -0,0 +1,52 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__ 1
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads consuming a FIFO task queue
+class ThreadPool {
+	public:
+		explicit ThreadPool(const uint32_t threads = 0); // 0 = one per hardware thread
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		~ThreadPool();
+
+		// Queues a task and returns a future for its result
+		template<typename F>
+		auto submit(F&& task) -> std::future<decltype(task())>;
+
+		uint32_t size() const { return static_cast<uint32_t>(workers_.size()); }
+
+		static ThreadPool& shared(); // Process-wide pool for loading work
+
+	private:
+		void workerLoop();
+
+		std::vector<std::thread> workers_;
+		std::queue<std::function<void()>> tasks_;
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		bool stopping_ = false;
+};
+
+template<typename F>
+auto ThreadPool::submit(F&& task) -> std::future<decltype(task())> {
+	using Result = decltype(task());
+	auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+	std::future<Result> result = packaged->get_future();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		tasks_.push([packaged]() { (*packaged)(); });
+	}
+	condition_.notify_one();
+	return result;
+}
+
+#endif
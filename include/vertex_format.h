@@ -0,0 +1,58 @@
+#ifndef __VERTEX_FORMAT_H__
+#define __VERTEX_FORMAT_H__ 1
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+struct Vertex;
+
+// GPU layout of mesh vertices. Attribute locations stay 0-4 in every format.
+enum class VertexFormat {
+	Full, // Vertex as is: float position, normal, UV, tangent and bitangent (56 bytes)
+	Packed, // float position, octahedral normal/tangent, half UVs (24 bytes)
+	PackedQuantized // Packed with 16-bit positions inside the mesh bounds (20 bytes)
+};
+
+// Octahedral normal and tangent as snorm16. The lowest bit of Tangent[1] holds
+// the bitangent sign (set = negative), so location 3 is read as an ivec2.
+struct PackedVertex {
+	glm::vec3 Position;
+	int16_t Normal[2];
+	int16_t Tangent[2];
+	uint16_t TexCoords[2]; // half floats
+};
+
+struct QuantizedVertex {
+	uint16_t Position[4]; // unorm16 in [bias, bias + scale], w is padding
+	int16_t Normal[2];
+	int16_t Tangent[2];
+	uint16_t TexCoords[2];
+};
+
+// Decode parameters of packed positions: position = attribute * scale + bias
+struct PositionQuantization {
+	glm::vec3 scale;
+	glm::vec3 bias;
+};
+
+uint32_t vertexStride(const VertexFormat format);
+
+// Quantization of a vertex array (identity for unquantized formats)
+PositionQuantization positionQuantization(const Vertex* vertices, const uint32_t numVertices, const VertexFormat format);
+
+// Converts vertices to the GPU layout of the format
+void packVertices(const Vertex* vertices, const uint32_t numVertices, const VertexFormat format,
+	std::vector<uint8_t>* packed);
+
+// Bytes per GPU index: 2 below 65536 vertices (0xFFFF stays free as a restart index), otherwise 4
+uint32_t indexSize(const size_t numVertices);
+
+// Converts indices to the GPU index size
+void packIndices(const uint32_t* indices, const uint32_t numIndices, const uint32_t indexSize,
+	std::vector<uint8_t>* packed);
+
+// Attribute pointers for the bound VAO and array buffer
+void setupVertexAttributes(const VertexFormat format);
+
+#endif
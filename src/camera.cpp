@@ -41,6 +41,16 @@ glm::mat4 Camera::getViewMatrix() const
 	return lookAt();
 }
 
+glm::mat4 Camera::getProjectionMatrix(const float aspect, const float zNear, const float zFar) const
+{
+	return glm::perspective(glm::radians(fov_), aspect, zNear, zFar);
+}
+
+Frustum Camera::getFrustum(const float aspect, const float zNear, const float zFar) const
+{
+	return Frustum::fromMatrix(getProjectionMatrix(aspect, zNear, zFar) * lookAt());
+}
+
 glm::mat4 Camera::lookAt() const
 {
 	return glm::lookAt(position_, position_ + front_, up_);
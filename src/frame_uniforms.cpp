@@ -0,0 +1,43 @@
+#include "frame_uniforms.h"
+#include "camera.h"
+
+#include <glad/glad.h>
+
+static_assert(sizeof(FrameData) == 224, "FrameData must match the std140 layout of the Frame block");
+
+FrameUniforms::FrameUniforms() :
+	data_{ glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::vec4(0.0f), glm::vec4(0.0f) }
+{
+	glGenBuffers(1, &UBO_);
+	glBindBuffer(GL_UNIFORM_BUFFER, UBO_);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), &data_, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, k_FrameBlockBinding, UBO_);
+}
+
+FrameUniforms::~FrameUniforms() {
+	glDeleteBuffers(1, &UBO_);
+}
+
+void FrameUniforms::setCamera(const Camera& camera, const float aspect, const float near, const float far) {
+	setCamera(glm::perspective(glm::radians(camera.getFOV()), aspect, near, far),
+		camera.getViewMatrix(), camera.getPosition());
+}
+
+void FrameUniforms::setCamera(const glm::mat4& projection, const glm::mat4& view, const glm::vec3& position) {
+	data_.projection = projection;
+	data_.view = view;
+	data_.viewPos = glm::vec4(position, 1.0f);
+}
+
+void FrameUniforms::setLight(const glm::vec3& position, const glm::mat4& lightSpaceMatrix) {
+	data_.lightPos = glm::vec4(position, 1.0f);
+	data_.lightSpaceMatrix = lightSpaceMatrix;
+}
+
+void FrameUniforms::upload() const {
+	glBindBuffer(GL_UNIFORM_BUFFER, UBO_);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data_);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, k_FrameBlockBinding, UBO_);
+}
@@ -0,0 +1,223 @@
+#include "frustum_cull.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mesh.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_CULL_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_CULL_SSE 1
+#endif
+
+namespace {
+	// Raw arrays of a CullBounds
+	struct BoundsView {
+		const float* centerX;
+		const float* centerY;
+		const float* centerZ;
+		const float* extentX;
+		const float* extentY;
+		const float* extentZ;
+		const float* radius;
+		size_t count;
+	};
+
+	// Tests volumes [first, count) one at a time
+	void cullScalar(const Frustum& frustum, const BoundsView& view, size_t first, std::vector<uint32_t>* visible) {
+		for (size_t i = first; i < view.count; i++) {
+			const glm::vec3 center(view.centerX[i], view.centerY[i], view.centerZ[i]);
+			const glm::vec3 extents(view.extentX[i], view.extentY[i], view.extentZ[i]);
+			if (frustum.intersects(center, extents, view.radius[i])) visible->push_back(static_cast<uint32_t>(i));
+		}
+	}
+
+#ifdef FRUSTUM_CULL_SSE
+	// Tests 4 volumes per iteration, returns the first one left for the scalar loop
+	size_t cullSSE(const Frustum& frustum, const BoundsView& view, std::vector<uint32_t>* visible) {
+		__m128 normalX[Frustum::Count], normalY[Frustum::Count], normalZ[Frustum::Count], distance[Frustum::Count];
+		__m128 absX[Frustum::Count], absY[Frustum::Count], absZ[Frustum::Count];
+		for (uint32_t p = 0; p < Frustum::Count; p++) {
+			const glm::vec4& plane = frustum.planes[p];
+			normalX[p] = _mm_set1_ps(plane.x);
+			normalY[p] = _mm_set1_ps(plane.y);
+			normalZ[p] = _mm_set1_ps(plane.z);
+			distance[p] = _mm_set1_ps(plane.w);
+			absX[p] = _mm_set1_ps(std::abs(plane.x));
+			absY[p] = _mm_set1_ps(std::abs(plane.y));
+			absZ[p] = _mm_set1_ps(std::abs(plane.z));
+		}
+		const __m128 zero = _mm_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 4 <= view.count; i += 4) {
+			const __m128 centerX = _mm_loadu_ps(view.centerX + i);
+			const __m128 centerY = _mm_loadu_ps(view.centerY + i);
+			const __m128 centerZ = _mm_loadu_ps(view.centerZ + i);
+			const __m128 extentX = _mm_loadu_ps(view.extentX + i);
+			const __m128 extentY = _mm_loadu_ps(view.extentY + i);
+			const __m128 extentZ = _mm_loadu_ps(view.extentZ + i);
+			const __m128 radius = _mm_loadu_ps(view.radius + i);
+
+			__m128 outside = zero;
+			for (uint32_t p = 0; p < Frustum::Count; p++) {
+				const __m128 signedDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX[p], centerX), _mm_mul_ps(normalY[p], centerY)),
+					_mm_add_ps(_mm_mul_ps(normalZ[p], centerZ), distance[p]));
+				const __m128 boxReach = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absX[p], extentX), _mm_mul_ps(absY[p], extentY)),
+					_mm_mul_ps(absZ[p], extentZ));
+				const __m128 reach = _mm_min_ps(radius, boxReach);
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(signedDistance, reach), zero));
+			}
+
+			const int mask = ~_mm_movemask_ps(outside) & 0xF;
+			for (uint32_t lane = 0; lane < 4; lane++) {
+				if (mask & (1 << lane)) visible->push_back(static_cast<uint32_t>(i + lane));
+			}
+		}
+		return i;
+	}
+#endif
+
+#ifdef FRUSTUM_CULL_AVX
+	// Tests 8 volumes per iteration, returns the first one left for the scalar loop
+	size_t cullAVX(const Frustum& frustum, const BoundsView& view, std::vector<uint32_t>* visible) {
+		__m256 normalX[Frustum::Count], normalY[Frustum::Count], normalZ[Frustum::Count], distance[Frustum::Count];
+		__m256 absX[Frustum::Count], absY[Frustum::Count], absZ[Frustum::Count];
+		for (uint32_t p = 0; p < Frustum::Count; p++) {
+			const glm::vec4& plane = frustum.planes[p];
+			normalX[p] = _mm256_set1_ps(plane.x);
+			normalY[p] = _mm256_set1_ps(plane.y);
+			normalZ[p] = _mm256_set1_ps(plane.z);
+			distance[p] = _mm256_set1_ps(plane.w);
+			absX[p] = _mm256_set1_ps(std::abs(plane.x));
+			absY[p] = _mm256_set1_ps(std::abs(plane.y));
+			absZ[p] = _mm256_set1_ps(std::abs(plane.z));
+		}
+		const __m256 zero = _mm256_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 8 <= view.count; i += 8) {
+			const __m256 centerX = _mm256_loadu_ps(view.centerX + i);
+			const __m256 centerY = _mm256_loadu_ps(view.centerY + i);
+			const __m256 centerZ = _mm256_loadu_ps(view.centerZ + i);
+			const __m256 extentX = _mm256_loadu_ps(view.extentX + i);
+			const __m256 extentY = _mm256_loadu_ps(view.extentY + i);
+			const __m256 extentZ = _mm256_loadu_ps(view.extentZ + i);
+			const __m256 radius = _mm256_loadu_ps(view.radius + i);
+
+			__m256 outside = zero;
+			for (uint32_t p = 0; p < Frustum::Count; p++) {
+				const __m256 signedDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX[p], centerX), _mm256_mul_ps(normalY[p], centerY)),
+					_mm256_add_ps(_mm256_mul_ps(normalZ[p], centerZ), distance[p]));
+				const __m256 boxReach = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(absX[p], extentX), _mm256_mul_ps(absY[p], extentY)),
+					_mm256_mul_ps(absZ[p], extentZ));
+				const __m256 reach = _mm256_min_ps(radius, boxReach);
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(signedDistance, reach), zero, _CMP_LT_OQ));
+			}
+
+			const int mask = ~_mm256_movemask_ps(outside) & 0xFF;
+			for (uint32_t lane = 0; lane < 8; lane++) {
+				if (mask & (1 << lane)) visible->push_back(static_cast<uint32_t>(i + lane));
+			}
+		}
+		return i;
+	}
+#endif
+}
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProj) {
+	// Gribb & Hartmann: each plane is the w row plus or minus another row of the matrix
+	const glm::vec4 rowX(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+	const glm::vec4 rowY(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+	const glm::vec4 rowZ(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+	const glm::vec4 rowW(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+	Frustum frustum;
+	frustum.planes[Left] = rowW + rowX;
+	frustum.planes[Right] = rowW - rowX;
+	frustum.planes[Bottom] = rowW + rowY;
+	frustum.planes[Top] = rowW - rowY;
+	frustum.planes[Near] = rowW + rowZ; // GL clip depth is [-w, w]
+	frustum.planes[Far] = rowW - rowZ;
+	for (glm::vec4& plane : frustum.planes)
+		plane /= glm::length(glm::vec3(plane));
+	return frustum;
+}
+
+bool Frustum::intersects(const glm::vec3& center, const glm::vec3& extents, const float radius) const {
+	for (const glm::vec4& plane : planes) {
+		const float signedDistance = glm::dot(glm::vec3(plane), center) + plane.w;
+		const float boxReach = glm::dot(glm::abs(glm::vec3(plane)), extents);
+		if (signedDistance + std::min(radius, boxReach) < 0.0f) return false;
+	}
+	return true;
+}
+
+void CullBounds::clear() {
+	centerX_.clear(); centerY_.clear(); centerZ_.clear();
+	extentX_.clear(); extentY_.clear(); extentZ_.clear();
+	radius_.clear();
+}
+
+void CullBounds::reserve(const size_t count) {
+	centerX_.reserve(count); centerY_.reserve(count); centerZ_.reserve(count);
+	extentX_.reserve(count); extentY_.reserve(count); extentZ_.reserve(count);
+	radius_.reserve(count);
+}
+
+uint32_t CullBounds::add(const glm::vec3& center, const glm::vec3& extents, const float radius) {
+	centerX_.push_back(center.x); centerY_.push_back(center.y); centerZ_.push_back(center.z);
+	extentX_.push_back(extents.x); extentY_.push_back(extents.y); extentZ_.push_back(extents.z);
+	radius_.push_back(radius);
+	return static_cast<uint32_t>(radius_.size() - 1);
+}
+
+uint32_t CullBounds::add(const Mesh& mesh, const glm::mat4& model) {
+	const glm::mat3 basis(model);
+	const glm::vec3 half = (mesh.boundsMax_ - mesh.boundsMin_) * 0.5f;
+	const glm::vec3 extents = glm::abs(basis[0]) * half.x + glm::abs(basis[1]) * half.y + glm::abs(basis[2]) * half.z;
+	const float scale = std::max(glm::length(basis[0]), std::max(glm::length(basis[1]), glm::length(basis[2])));
+	return add(glm::vec3(model * glm::vec4(mesh.boundsCenter_, 1.0f)), extents, mesh.boundsRadius_ * scale);
+}
+
+CullPath bestCullPath() {
+#if defined(FRUSTUM_CULL_AVX)
+	return CullPath::AVX;
+#elif defined(FRUSTUM_CULL_SSE)
+	return CullPath::SSE;
+#else
+	return CullPath::Scalar;
+#endif
+}
+
+const char* cullPathName(const CullPath path) {
+	switch (path) {
+		case CullPath::AVX: return "AVX";
+		case CullPath::SSE: return "SSE";
+		default: return "Scalar";
+	}
+}
+
+void cullBounds(const Frustum& frustum, const CullBounds& bounds, std::vector<uint32_t>* visible, const CullPath path) {
+	const BoundsView view = {
+		bounds.centerX_.data(), bounds.centerY_.data(), bounds.centerZ_.data(),
+		bounds.extentX_.data(), bounds.extentY_.data(), bounds.extentZ_.data(),
+		bounds.radius_.data(), bounds.size()
+	};
+
+	size_t first = 0;
+	switch (std::min(path, bestCullPath())) {
+#ifdef FRUSTUM_CULL_AVX
+		case CullPath::AVX: first = cullAVX(frustum, view, visible); break;
+#endif
+#ifdef FRUSTUM_CULL_SSE
+		case CullPath::SSE: first = cullSSE(frustum, view, visible); break;
+#endif
+		default: break;
+	}
+	cullScalar(frustum, view, first, visible);
+}
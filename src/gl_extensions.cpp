@@ -0,0 +1,74 @@
+#include "gl_extensions.h"
+
+#include <cstring>
+
+#include <GLFW/glfw3.h>
+
+namespace {
+	GLExtensions g_Extensions;
+	bool g_Loaded = false;
+
+	template<typename T>
+	bool load(T* function, const char* name) {
+		*function = reinterpret_cast<T>(glfwGetProcAddress(name));
+		return *function != nullptr;
+	}
+
+	void loadExtensions(GLExtensions& ext) {
+		if (hasGLVersion(4, 1) || hasGLExtension("GL_ARB_get_program_binary")) {
+			ext.programBinary = load(&ext.getProgramBinary, "glGetProgramBinary") &&
+				load(&ext.programBinaryLoad, "glProgramBinary") &&
+				load(&ext.programParameteri, "glProgramParameteri");
+		}
+		if (ext.programBinary) {
+			// A driver may expose the entry points and still not support any binary format
+			GLint formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			ext.programBinary = formats > 0;
+		}
+
+		if (hasGLExtension("GL_KHR_parallel_shader_compile")) {
+			ext.parallelShaderCompile = load(&ext.maxShaderCompilerThreads, "glMaxShaderCompilerThreadsKHR");
+		}
+		else if (hasGLExtension("GL_ARB_parallel_shader_compile")) {
+			ext.parallelShaderCompile = load(&ext.maxShaderCompilerThreads, "glMaxShaderCompilerThreadsARB");
+		}
+		if (ext.parallelShaderCompile) {
+			ext.maxShaderCompilerThreads(0xFFFFFFFF); // as many threads as the driver likes
+		}
+
+		if (hasGLVersion(4, 3) || (hasGLExtension("GL_ARB_multi_draw_indirect") &&
+			hasGLExtension("GL_ARB_draw_indirect") && hasGLExtension("GL_ARB_base_instance"))) {
+			ext.multiDrawIndirect = load(&ext.multiDrawElementsIndirect, "glMultiDrawElementsIndirect");
+		}
+
+		if (hasGLVersion(4, 4) || hasGLExtension("GL_ARB_buffer_storage")) {
+			ext.bufferStorage = load(&ext.createBufferStorage, "glBufferStorage");
+		}
+	}
+}
+
+const GLExtensions& glExtensions() {
+	if (!g_Loaded) {
+		g_Loaded = true;
+		loadExtensions(g_Extensions);
+	}
+	return g_Extensions;
+}
+
+bool hasGLVersion(const int major, const int minor) {
+	GLint currentMajor = 0, currentMinor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &currentMajor);
+	glGetIntegerv(GL_MINOR_VERSION, &currentMinor);
+	return currentMajor > major || (currentMajor == major && currentMinor >= minor);
+}
+
+bool hasGLExtension(const char* name) {
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (GLint i = 0; i < count; i++) {
+		const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+		if (extension && std::strcmp(extension, name) == 0) return true;
+	}
+	return false;
+}
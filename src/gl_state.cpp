@@ -0,0 +1,153 @@
+#include "gl_state.h"
+
+#include <cstring>
+
+#include <glad/glad.h>
+
+namespace {
+	const uint32_t k_Unknown = 0xFFFFFFFFu;
+
+	int32_t targetIndex(const uint32_t target) {
+		switch (target) {
+			case GL_TEXTURE_2D: return 0;
+			case GL_TEXTURE_CUBE_MAP: return 1;
+			case GL_TEXTURE_BUFFER: return 2;
+			default: return -1;
+		}
+	}
+}
+
+GLState& GLState::instance() {
+	static GLState state;
+	return state;
+}
+
+GLState::GLState() {
+	invalidate();
+}
+
+void GLState::invalidate() {
+	program_ = VAO_ = FBO_ = activeUnit_ = k_Unknown;
+	std::memset(textures_, 0xFF, sizeof(textures_));
+	blend_ = depthTest_ = depthFunc_ = depthMask_ = k_Unknown;
+	stencilTest_ = stencilMask_ = cullFace_ = cullFaceMode_ = k_Unknown;
+	std::memset(blendFunc_, 0xFF, sizeof(blendFunc_));
+	std::memset(stencilFunc_, 0xFF, sizeof(stencilFunc_));
+	std::memset(stencilOp_, 0xFF, sizeof(stencilOp_));
+}
+
+void GLState::setElision(const bool enabled) {
+	elision_ = enabled;
+}
+
+bool GLState::changed(uint32_t* current, const uint32_t* values, const uint32_t count) {
+	if (elision_ && std::memcmp(current, values, count * sizeof(uint32_t)) == 0) {
+		stats_.elided++;
+		return false;
+	}
+	std::memcpy(current, values, count * sizeof(uint32_t));
+	stats_.issued++;
+	return true;
+}
+
+void GLState::setCapability(uint32_t& current, const uint32_t capability, const bool enabled) {
+	if (!changed(current, enabled ? 1u : 0u)) return;
+	if (enabled) glEnable(capability);
+	else glDisable(capability);
+}
+
+void GLState::useProgram(const uint32_t program) {
+	if (changed(program_, program)) glUseProgram(program);
+}
+
+void GLState::bindVertexArray(const uint32_t VAO) {
+	if (changed(VAO_, VAO)) glBindVertexArray(VAO);
+}
+
+void GLState::bindFramebuffer(const uint32_t FBO) {
+	if (changed(FBO_, FBO)) glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+}
+
+void GLState::activeTexture(const uint32_t unit) {
+	if (changed(activeUnit_, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLState::bindTexture(const uint32_t unit, const uint32_t target, const uint32_t texture) {
+	const int32_t index = targetIndex(target);
+	if (unit >= k_MaxTextureUnits || index < 0) { // not tracked
+		activeTexture(unit);
+		glBindTexture(target, texture);
+		stats_.issued++;
+		return;
+	}
+	if (!changed(textures_[unit][index], texture)) return;
+	activeTexture(unit);
+	glBindTexture(target, texture);
+}
+
+void GLState::setBlend(const bool enabled) {
+	setCapability(blend_, GL_BLEND, enabled);
+}
+
+void GLState::blendFunc(const uint32_t src, const uint32_t dst) {
+	const uint32_t values[2] = { src, dst };
+	if (changed(blendFunc_, values, 2)) glBlendFunc(src, dst);
+}
+
+void GLState::setDepthTest(const bool enabled) {
+	setCapability(depthTest_, GL_DEPTH_TEST, enabled);
+}
+
+void GLState::depthFunc(const uint32_t func) {
+	if (changed(depthFunc_, func)) glDepthFunc(func);
+}
+
+void GLState::depthMask(const bool write) {
+	if (changed(depthMask_, write ? 1u : 0u)) glDepthMask(write ? GL_TRUE : GL_FALSE);
+}
+
+void GLState::setStencilTest(const bool enabled) {
+	setCapability(stencilTest_, GL_STENCIL_TEST, enabled);
+}
+
+void GLState::stencilFunc(const uint32_t func, const int32_t ref, const uint32_t mask) {
+	const uint32_t values[3] = { func, static_cast<uint32_t>(ref), mask };
+	if (changed(stencilFunc_, values, 3)) glStencilFunc(func, ref, mask);
+}
+
+void GLState::stencilOp(const uint32_t stencilFail, const uint32_t depthFail, const uint32_t depthPass) {
+	const uint32_t values[3] = { stencilFail, depthFail, depthPass };
+	if (changed(stencilOp_, values, 3)) glStencilOp(stencilFail, depthFail, depthPass);
+}
+
+void GLState::stencilMask(const uint32_t mask) {
+	if (changed(stencilMask_, mask)) glStencilMask(mask);
+}
+
+void GLState::setCullFace(const bool enabled) {
+	setCapability(cullFace_, GL_CULL_FACE, enabled);
+}
+
+void GLState::cullFace(const uint32_t mode) {
+	if (changed(cullFaceMode_, mode)) glCullFace(mode);
+}
+
+void GLState::forgetProgram(const uint32_t program) {
+	if (program_ == program) program_ = k_Unknown;
+}
+
+void GLState::forgetVertexArray(const uint32_t VAO) {
+	if (VAO_ == VAO) VAO_ = k_Unknown;
+}
+
+void GLState::forgetFramebuffer(const uint32_t FBO) {
+	if (FBO_ == FBO) FBO_ = k_Unknown;
+}
+
+void GLState::forgetTexture(const uint32_t texture) {
+	for (uint32_t unit = 0; unit < k_MaxTextureUnits; unit++) {
+		for (uint32_t target = 0; target < k_TextureTargets; target++) {
+			if (textures_[unit][target] == texture) textures_[unit][target] = k_Unknown;
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#include "indirect_draw.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "gl_extensions.h"
+#include "gl_state.h"
+#include "mesh.h"
+#include "shader.h"
+
+namespace {
+	IndirectDrawStats g_Stats;
+
+	// Texture names of a mesh, plus the mesh itself when it has decode uniforms of its own
+	std::vector<uint32_t> materialKey(const Mesh& mesh, const uint32_t index) {
+		std::vector<uint32_t> key;
+		for (const Texture& texture : mesh.textures_) key.push_back(texture.id);
+		if (mesh.format_ == VertexFormat::PackedQuantized) key.push_back(index);
+		return key;
+	}
+}
+
+IndirectDrawList::IndirectDrawList(const std::vector<Mesh>& meshes, const uint32_t VAO, const uint32_t indexSize) :
+	VAO_(VAO),
+	indexType_(indexSize == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT)
+{
+	std::vector<uint32_t> order(meshes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::vector<std::vector<uint32_t>> keys(meshes.size());
+	for (uint32_t i = 0; i < meshes.size(); i++) keys[i] = materialKey(meshes[i], i);
+	std::stable_sort(order.begin(), order.end(), [&keys](const uint32_t a, const uint32_t b) { return keys[a] < keys[b]; });
+
+	std::vector<uint32_t> materials;
+	for (const uint32_t i : order) {
+		const Mesh& mesh = meshes[i];
+		if (groups_.empty() || keys[i] != keys[order[groups_.back().first]]) {
+			const Group group = { static_cast<uint32_t>(commands_.size()), 0, i };
+			groups_.push_back(group);
+		}
+		groups_.back().count++;
+
+		const MeshLod& level = mesh.lods_[0];
+		const DrawElementsIndirectCommand command = {
+			level.numIndices,
+			1,
+			mesh.firstIndex_ + level.firstIndex,
+			static_cast<int32_t>(mesh.baseVertex_),
+			static_cast<uint32_t>(commands_.size()) // selects the material of this draw
+		};
+		commands_.push_back(command);
+		materials.push_back(static_cast<uint32_t>(groups_.size() - 1));
+		counts_.push_back(static_cast<int32_t>(command.count));
+		offsets_.push_back((const void*)(size_t(command.firstIndex) * indexSize));
+		baseVertices_.push_back(command.baseVertex);
+	}
+
+	if (!glExtensions().multiDrawIndirect || commands_.empty()) return;
+
+	glGenBuffers(1, &commandBuffer_);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer_);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, commands_.size() * sizeof(DrawElementsIndirectCommand), commands_.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	glGenBuffers(1, &materialBuffer_);
+	GLState::instance().bindVertexArray(VAO_);
+	glBindBuffer(GL_ARRAY_BUFFER, materialBuffer_);
+	glBufferData(GL_ARRAY_BUFFER, materials.size() * sizeof(uint32_t), materials.data(), GL_STATIC_DRAW);
+	glVertexAttribIPointer(k_MaterialIndexLocation, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+	glEnableVertexAttribArray(k_MaterialIndexLocation);
+	glVertexAttribDivisor(k_MaterialIndexLocation, 1);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+IndirectDrawList::~IndirectDrawList() {
+	glDeleteBuffers(1, &commandBuffer_);
+	glDeleteBuffers(1, &materialBuffer_);
+}
+
+const IndirectDrawStats& IndirectDrawList::stats() {
+	return g_Stats;
+}
+
+void IndirectDrawList::resetStats() {
+	g_Stats = IndirectDrawStats();
+}
+
+void IndirectDrawList::draw(const Shader& shader, const std::vector<Mesh>& meshes) const {
+	if (commands_.empty()) return;
+
+	GLState::instance().bindVertexArray(VAO_);
+	if (commandBuffer_) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer_);
+
+	// Groups only differ by what Mesh::bind sets. The fallback has a single material index
+	// per call, so it keeps the groups apart whenever there are several.
+	const Mesh& first = meshes[groups_[0].mesh];
+	bool perGroup = first.format_ == VertexFormat::PackedQuantized || (!commandBuffer_ && groups_.size() > 1);
+	for (uint32_t i = 0; i < groups_.size() && !perGroup; i++) {
+		for (const UniformName& sampler : meshes[groups_[i].mesh].samplers_) {
+			if (shader.uniform(sampler).slot >= 0) perGroup = true;
+		}
+	}
+
+	if (!perGroup) {
+		first.bind(shader);
+		submit(0, drawCount(), 0);
+	}
+	else {
+		for (uint32_t i = 0; i < groups_.size(); i++) {
+			const Group& group = groups_[i];
+			meshes[group.mesh].bind(shader);
+			submit(group.first, group.count, i);
+		}
+	}
+
+	if (commandBuffer_) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void IndirectDrawList::submit(const uint32_t first, const uint32_t count, const uint32_t material) const {
+	if (commandBuffer_) {
+		glExtensions().multiDrawElementsIndirect(GL_TRIANGLES, indexType_,
+			(const void*)(size_t(first) * sizeof(DrawElementsIndirectCommand)), count, 0);
+	}
+	else {
+		glVertexAttribI4ui(k_MaterialIndexLocation, material, 0, 0, 0);
+		glMultiDrawElementsBaseVertex(GL_TRIANGLES, &counts_[first], indexType_, &offsets_[first], count, &baseVertices_[first]);
+	}
+	g_Stats.calls++;
+	g_Stats.draws += count;
+}
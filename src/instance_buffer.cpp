@@ -0,0 +1,61 @@
+#include "instance_buffer.h"
+#include "gl_state.h"
+
+#include <glad/glad.h>
+
+InstanceBuffer::InstanceBuffer(const uint32_t capacity) :
+	capacity_(capacity > 0 ? capacity : 1)
+{
+	glGenBuffers(1, &buffer_);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+	glBufferData(GL_ARRAY_BUFFER, capacity_ * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+InstanceBuffer::~InstanceBuffer() {
+	glDeleteBuffers(1, &buffer_);
+}
+
+void InstanceBuffer::attach(const uint32_t VAO) const {
+	GLState::instance().bindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+	for (uint32_t i = 0; i < 4; i++) {
+		const uint32_t location = k_InstanceModelLocation + i;
+		glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+			(void*)(offsetof(InstanceData, model) + i * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+	for (uint32_t i = 0; i < 3; i++) {
+		const uint32_t location = k_InstanceNormalMatLocation + i;
+		glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+			(void*)(offsetof(InstanceData, normalMat) + i * sizeof(glm::vec3)));
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::upload(const InstanceData* instances, const uint32_t count) {
+	glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+	while (capacity_ < count) capacity_ *= 2;
+	glBufferData(GL_ARRAY_BUFFER, capacity_ * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+	if (count > 0) glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData), instances);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	size_ = count;
+}
+
+void InstanceBuffer::upload(const glm::mat4* models, const uint32_t count) {
+	staging_.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		staging_[i].model = models[i];
+		staging_[i].normalMat = glm::transpose(glm::inverse(glm::mat3(models[i])));
+	}
+	upload(staging_.data(), count);
+}
+
+void InstanceBuffer::draw(const uint32_t VAO, const uint32_t indexCount) const {
+	if (size_ == 0) return;
+	GLState::instance().bindVertexArray(VAO);
+	glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, size_);
+}
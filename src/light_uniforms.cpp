@@ -0,0 +1,67 @@
+#include "light_uniforms.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+static_assert(sizeof(DirLight) == 64, "DirLight must match the std140 layout of the GLSL struct");
+static_assert(sizeof(PointLight) == 80, "PointLight must match the std140 layout of the GLSL struct");
+static_assert(offsetof(PointLight, constant) == 60, "PointLight::constant packs behind specular in std140");
+static_assert(sizeof(MaterialParams) == 16, "MaterialParams must match the std140 layout of the block");
+
+LightUniforms::LightUniforms(const uint32_t maxPointLights) :
+	maxPointLights_(maxPointLights)
+{
+	std::memset(&header_, 0, sizeof(header_));
+
+	const size_t blockBytes = sizeof(Header) + maxPointLights_ * sizeof(PointLight);
+	if (blockBytes <= StructBuffer::maxUniformBlockSize()) {
+		block_.reset(new StructBuffer(StructBuffer::Storage::UniformBlock, k_LightsBlockBinding, blockBytes));
+	}
+	else {
+		block_.reset(new StructBuffer(StructBuffer::Storage::UniformBlock, k_LightsBlockBinding, sizeof(Header)));
+		pointLights_.reset(new StructBuffer(StructBuffer::Storage::TextureBuffer, k_PointLightTextureUnit,
+			maxPointLights_ * sizeof(PointLight)));
+	}
+	setPointLights(nullptr, 0); // block entries start unlit
+}
+
+void LightUniforms::setDirLight(const DirLight& light) {
+	header_.dirLight = light;
+}
+
+void LightUniforms::setPointLights(const PointLight* lights, const uint32_t count) {
+	if (count > maxPointLights_) {
+		std::cout << "ERROR::LIGHTUNIFORMS:: " << count << " point lights, room for " << maxPointLights_ << std::endl;
+	}
+	lights_.assign(lights, lights + std::min(count, maxPointLights_));
+	header_.numPointLights = static_cast<int32_t>(lights_.size());
+	if (pointLights_) return;
+
+	// The block variant loops over every entry, a zero color adds nothing and a constant
+	// of 1 keeps the attenuation finite
+	PointLight unlit;
+	std::memset(&unlit, 0, sizeof(unlit));
+	unlit.constant = 1.0f;
+	lights_.resize(maxPointLights_, unlit);
+}
+
+void LightUniforms::upload() const {
+	block_->upload(&header_, 1);
+	block_->bind();
+	if (lights_.empty()) return;
+	if (pointLights_) {
+		pointLights_->upload(lights_.data(), static_cast<uint32_t>(lights_.size()));
+		pointLights_->bind();
+	}
+	else {
+		block_->upload(lights_.data(), static_cast<uint32_t>(lights_.size()), sizeof(Header));
+	}
+}
+
+ShaderDefines LightUniforms::defines() const {
+	if (pointLights_) return { { "POINT_LIGHTS_TEXTURE_BUFFER", "" } };
+	return { { "MAX_POINT_LIGHTS", std::to_string(std::max(maxPointLights_, 1u)) } };
+}
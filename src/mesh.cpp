@@ -1,25 +1,149 @@
 
 #include "mesh.h"
 #include "shader.h"
+#include "gl_state.h"
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+
+// UniformName keeps only a pointer to its text, so built sampler names are kept here for
+// good. There is one per texture type and number, a handful per process.
+static const char* internSamplerName(const std::string& name) {
+	static std::mutex mutex;
+	static std::unordered_set<std::string> names; // nodes never move
+	std::lock_guard<std::mutex> lock(mutex);
+	return names.insert(name).first->c_str();
+}
+
+MeshView viewOf(const MeshData& mesh) {
+	MeshView view;
+	view.vertices = mesh.vertices.data();
+	view.numVertices = static_cast<uint32_t>(mesh.vertices.size());
+	view.indices = mesh.indices.data();
+	view.numIndices = static_cast<uint32_t>(mesh.indices.size());
+	view.textures = mesh.textures;
+	view.lods = mesh.lods.data();
+	view.numLods = static_cast<uint32_t>(mesh.lods.size());
+	return view;
+}
+
 Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
-	std::vector<Texture> textures) {
-	vertices_ = vertices;
-	indices_ = indices;
-	textures_ = textures;
-	setupMesh();
+	std::vector<Texture> textures) :
+	vertices_(std::move(vertices)),
+	indices_(std::move(indices)),
+	textures_(std::move(textures))
+{
+	const MeshLod full = { 0, static_cast<uint32_t>(indices_.size()), 0.0f }; // setupView copies it into lods_
+	MeshView view = { vertices_.data(), static_cast<uint32_t>(vertices_.size()),
+		indices_.data(), static_cast<uint32_t>(indices_.size()), {}, &full, 1 };
+	setupView(view);
+	setupMesh(view.vertices, view.numVertices, view.indices, view.numIndices);
+}
+
+Mesh::Mesh(const MeshView& view, const VertexFormat format, const CpuGeometry cpu) :
+	format_(format),
+	quantization_(positionQuantization(view.vertices, view.numVertices, format))
+{
+	textures_ = view.textures;
+	setupView(view);
+	setupMesh(view.vertices, view.numVertices, view.indices, view.numIndices);
+	keepCpuGeometry(view, cpu);
+}
+
+Mesh::Mesh(MeshData&& data, const VertexFormat format, const CpuGeometry cpu) :
+	Mesh(viewOf(data), format, CpuGeometry::Discard)
+{
+	takeCpuGeometry(std::move(data), cpu);
+}
+
+Mesh::Mesh(const MeshView& view, const MeshRange& range, const VertexFormat format, const CpuGeometry cpu) :
+	VAO_(range.VAO),
+	baseVertex_(range.baseVertex),
+	firstIndex_(range.firstIndex),
+	indexSize_(range.indexSize),
+	format_(format),
+	quantization_(positionQuantization(view.vertices, view.numVertices, format))
+{
+	textures_ = view.textures;
+	setupView(view);
+	keepCpuGeometry(view, cpu);
+}
+
+Mesh::Mesh(MeshData&& data, const MeshRange& range, const VertexFormat format, const CpuGeometry cpu) :
+	Mesh(viewOf(data), range, format, CpuGeometry::Discard)
+{
+	takeCpuGeometry(std::move(data), cpu);
 }
 
 void Mesh::Draw(const Shader& shader) const {
+	bind(shader);
+	GLState::instance().bindVertexArray(VAO_); // stays bound, the next draw of this mesh binds nothing
+	drawElements();
+}
+
+void Mesh::bind(const Shader& shader) const {
+	static const UniformName k_PositionScale("positionScale");
+	static const UniformName k_PositionBias("positionBias");
+	if (format_ != VertexFormat::Full) {
+		shader.set(k_PositionScale, quantization_.scale);
+		shader.set(k_PositionBias, quantization_.bias);
+	}
+
+	GLState& state = GLState::instance();
+	for (uint8_t i = 0; i < textures_.size(); i++) {
+		shader.set(samplers_[i], static_cast<int>(i));
+		state.bindTexture(i, GL_TEXTURE_2D, textures_[i].id);
+	}
+	state.activeTexture(0); // direct glBindTexture calls elsewhere expect unit 0
+}
+
+void Mesh::drawElements(const uint32_t lod) const {
+	const MeshLod& level = lods_[lod];
+	glDrawElementsBaseVertex(GL_TRIANGLES, level.numIndices,
+		indexSize_ == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+		(void*)(size_t(firstIndex_ + level.firstIndex) * indexSize_), baseVertex_);
+}
+
+uint32_t Mesh::selectLod(const float maxError, const uint32_t current, const float hysteresis) const {
+	uint32_t lod = current < lods_.size() ? current : 0;
+	while (lod > 0 && lods_[lod].error > maxError) lod--; // too coarse, refine at once
+	while (lod + 1 < lods_.size() && lods_[lod + 1].error <= maxError * (1.0f - hysteresis)) lod++;
+	return lod;
+}
+
+void Mesh::releaseCpuGeometry(const CpuGeometry cpu) {
+	if (cpu == CpuGeometry::Keep) return;
+	if (cpu == CpuGeometry::Collision && !vertices_.empty()) {
+		std::vector<glm::vec3> positions(vertices_.size());
+		for (size_t i = 0; i < vertices_.size(); i++)
+			positions[i] = vertices_[i].Position;
+		positions_.swap(positions);
+		indices_.resize(std::min<size_t>(indices_.size(), lods_[0].numIndices));
+		indices_.shrink_to_fit();
+	}
+	else if (cpu == CpuGeometry::Discard) {
+		std::vector<uint32_t>().swap(indices_);
+		std::vector<glm::vec3>().swap(positions_);
+	}
+	std::vector<Vertex>().swap(vertices_);
+}
+
+size_t Mesh::cpuBytes() const {
+	return vertices_.capacity() * sizeof(Vertex) + indices_.capacity() * sizeof(uint32_t) +
+		positions_.capacity() * sizeof(glm::vec3) + lods_.capacity() * sizeof(MeshLod);
+}
+
+void Mesh::setupView(const MeshView& view) {
+	// Sampler names only depend on the texture types, so they are hashed once here
 	uint32_t diffuseNr = 1;
 	uint32_t specularNr = 1;
 	uint32_t normalNr = 1;
 	uint32_t heightNr = 1;
-	for (uint8_t i = 0; i < textures_.size(); i++) {
-		glActiveTexture(GL_TEXTURE0 + i); // retrieve texture number - diffuse_textureN
+	for (const Texture& texture : textures_) { // retrieve texture number - diffuse_textureN
 		std::string number;
-		std::string name = textures_[i].type;
+		const std::string& name = texture.type;
 		if (name == "texture_diffuse")
 			number = std::to_string(diffuseNr++);
 		else if (name == "texture_specular")
@@ -28,50 +152,76 @@ void Mesh::Draw(const Shader& shader) const {
 			number = std::to_string(normalNr++);
 		else if (name == "texture_height")
 			number = std::to_string(heightNr++);
-		shader.set((name + number).c_str(), i);
-		glBindTexture(GL_TEXTURE_2D, textures_[i].id);
+		samplers_.push_back(UniformName(internSamplerName(name + number)));
+	}
+
+	lods_.assign(view.lods, view.lods + view.numLods);
+	if (lods_.empty()) lods_.push_back({ 0, view.numIndices, 0.0f });
+
+	if (view.numVertices == 0) return;
+	glm::vec3 min = view.vertices[0].Position, max = view.vertices[0].Position;
+	for (uint32_t i = 1; i < view.numVertices; i++) {
+		min = glm::min(min, view.vertices[i].Position);
+		max = glm::max(max, view.vertices[i].Position);
+	}
+	boundsMin_ = min;
+	boundsMax_ = max;
+	boundsCenter_ = (min + max) * 0.5f;
+	boundsRadius_ = 0.0f;
+	for (uint32_t i = 0; i < view.numVertices; i++)
+		boundsRadius_ = std::max(boundsRadius_, glm::length(view.vertices[i].Position - boundsCenter_));
+}
+
+void Mesh::keepCpuGeometry(const MeshView& view, const CpuGeometry cpu) {
+	if (cpu == CpuGeometry::Keep) {
+		vertices_.assign(view.vertices, view.vertices + view.numVertices);
+		indices_.assign(view.indices, view.indices + view.numIndices);
+	}
+	else if (cpu == CpuGeometry::Collision) {
+		positions_.resize(view.numVertices);
+		for (uint32_t i = 0; i < view.numVertices; i++)
+			positions_[i] = view.vertices[i].Position;
+		indices_.assign(view.indices + lods_[0].firstIndex, view.indices + lods_[0].firstIndex + lods_[0].numIndices);
 	}
-	glBindVertexArray(VAO_);
-	glDrawElements(GL_TRIANGLES, indices_.size(), GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
-	glActiveTexture(GL_TEXTURE0);
 }
 
-void Mesh::setupMesh() {
+void Mesh::takeCpuGeometry(MeshData&& data, const CpuGeometry cpu) {
+	if (cpu != CpuGeometry::Keep) {
+		keepCpuGeometry(viewOf(data), cpu);
+		return;
+	}
+	vertices_ = std::move(data.vertices);
+	indices_ = std::move(data.indices);
+}
+
+void Mesh::setupMesh(const Vertex* vertices, const uint32_t numVertices,
+	const uint32_t* indices, const uint32_t numIndices) {
 	glGenVertexArrays(1, &VAO_);
 	glGenBuffers(1, &VBO_);
 	glGenBuffers(1, &EBO_);
 
-	glBindVertexArray(VAO_);
+	GLState::instance().bindVertexArray(VAO_);
 	glBindBuffer(GL_ARRAY_BUFFER, VBO_);
 
-	glBufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(Vertex), &vertices_[0], GL_STATIC_DRAW);
+	if (format_ == VertexFormat::Full) {
+		glBufferData(GL_ARRAY_BUFFER, numVertices * sizeof(Vertex), vertices, GL_STATIC_DRAW);
+	}
+	else {
+		std::vector<uint8_t> packed;
+		packVertices(vertices, numVertices, format_, &packed);
+		glBufferData(GL_ARRAY_BUFFER, packed.size(), packed.data(), GL_STATIC_DRAW);
+	}
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(uint32_t), &indices_[0], GL_STATIC_DRAW);
-	
-	// vertex Positions
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	
-	// vertex normals
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-		(void*)offsetof(Vertex, Normal));
-	
-	// vertex texture coords
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-		(void*)offsetof(Vertex, TexCoords));
-	
-	// vertex tangent
-	glEnableVertexAttribArray(3);
-	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-		(void*)offsetof(Vertex, Tangent));
+	indexSize_ = indexSize(numVertices);
+	if (indexSize_ == sizeof(uint32_t)) {
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, numIndices * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+	}
+	else {
+		std::vector<uint8_t> packed;
+		packIndices(indices, numIndices, indexSize_, &packed);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, packed.size(), packed.data(), GL_STATIC_DRAW);
+	}
 	
-	// vertex bitangent
-	glEnableVertexAttribArray(4);
-	glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-		(void*)offsetof(Vertex, Bitangent));
-	glBindVertexArray(0);
+	setupVertexAttributes(format_);
+	GLState::instance().bindVertexArray(0);
 }
-
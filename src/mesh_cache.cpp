@@ -0,0 +1,367 @@
+#include "mesh_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	const char k_Magic[4] = { 'M', 'V', 'M', 'C' };
+	const uint64_t k_FNVOffset = 14695981039346656037ULL;
+	const uint64_t k_FNVPrime = 1099511628211ULL;
+
+	struct FileHeader {
+		char magic[4];
+		uint32_t version;
+		uint64_t sourceHash;
+		uint32_t importFlags;
+		uint32_t vertexSize;
+		uint32_t meshCount;
+		uint32_t nodeCount;
+		uint64_t sceneOffset; // node table, after the data of every mesh
+	};
+
+	struct MeshEntry {
+		uint64_t vertexOffset;
+		uint64_t indexOffset;
+		uint64_t textureOffset;
+		uint64_t lodOffset;
+		uint32_t numVertices;
+		uint32_t numIndices;
+		uint32_t numTextures;
+		uint32_t numLods;
+	};
+
+	// Followed by numDraws mesh indices and the name, padded to 4 bytes
+	struct NodeEntry {
+		int32_t parent;
+		uint32_t numDraws;
+		uint32_t nameLength;
+		uint32_t pad;
+		glm::mat4 local;
+	};
+
+	uint64_t hashBytes(const uint8_t* data, const size_t size, uint64_t hash = k_FNVOffset) {
+		for (size_t i = 0; i < size; i++) {
+			hash ^= data[i];
+			hash *= k_FNVPrime;
+		}
+		return hash;
+	}
+
+	size_t align(const size_t offset, const size_t alignment) {
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+
+	void writePadding(std::ofstream& out, size_t& offset, const size_t alignment) {
+		const char zeros[16] = {};
+		const size_t aligned = align(offset, alignment);
+		out.write(zeros, aligned - offset);
+		offset = aligned;
+	}
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& path) {
+	close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	file_ = file;
+	mapping_ = mapping;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void MappedFile::close() {
+	if (data_) UnmapViewOfFile(data_);
+	if (mapping_) CloseHandle(mapping_);
+	if (file_) CloseHandle(file_);
+	data_ = nullptr;
+	mapping_ = nullptr;
+	file_ = nullptr;
+	size_ = 0;
+}
+#else
+bool MappedFile::open(const std::string& path) {
+	close();
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); // the mapping keeps its own reference
+	if (view == MAP_FAILED) return false;
+
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(info.st_size);
+	return true;
+}
+
+void MappedFile::close() {
+	if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+	data_ = nullptr;
+	size_ = 0;
+}
+#endif
+
+MeshCache::MeshCache(const std::string& sourcePath, const uint32_t importFlags) :
+	sourcePath_(sourcePath),
+	cachePath_(sourcePath + ".meshcache"),
+	importFlags_(importFlags)
+{
+	MappedFile source;
+	if (source.open(sourcePath_)) {
+		sourceHash_ = hashBytes(source.data(), source.size());
+	}
+}
+
+bool MeshCache::load() {
+	if (sourceHash_ == 0 || !file_.open(cachePath_)) return false;
+
+	const FileHeader* header = reinterpret_cast<const FileHeader*>(file_.data());
+	const bool valid = file_.size() >= sizeof(FileHeader) &&
+		std::memcmp(header->magic, k_Magic, sizeof(k_Magic)) == 0 &&
+		header->version == k_Version &&
+		header->sourceHash == sourceHash_ &&
+		header->importFlags == importFlags_ &&
+		header->vertexSize == sizeof(Vertex) &&
+		file_.size() >= sizeof(FileHeader) + header->meshCount * sizeof(MeshEntry);
+	if (!valid) {
+		file_.close();
+		return false;
+	}
+
+	const MeshEntry* entries = reinterpret_cast<const MeshEntry*>(file_.data() + sizeof(FileHeader));
+	for (uint32_t i = 0; i < header->meshCount; i++) {
+		const MeshEntry& entry = entries[i];
+		if (entry.vertexOffset + uint64_t(entry.numVertices) * sizeof(Vertex) > file_.size() ||
+			entry.indexOffset + uint64_t(entry.numIndices) * sizeof(uint32_t) > file_.size() ||
+			entry.textureOffset > file_.size() ||
+			entry.lodOffset + uint64_t(entry.numLods) * sizeof(MeshLod) > file_.size()) {
+			std::cout << "ERROR::MESHCACHE:: Corrupt cache file " << cachePath_ << std::endl;
+			file_.close();
+			return false;
+		}
+	}
+
+	// Walk the node table once, so scene() can trust it
+	size_t offset = header->sceneOffset;
+	for (uint32_t i = 0; i < header->nodeCount; i++) {
+		if (offset + sizeof(NodeEntry) > file_.size()) {
+			offset = file_.size() + 1;
+			break;
+		}
+		NodeEntry node;
+		std::memcpy(&node, file_.data() + offset, sizeof(node));
+		offset += sizeof(NodeEntry) + node.numDraws * sizeof(uint32_t) + align(node.nameLength, 4);
+		// Depth first, so a parent always comes first
+		if (node.parent >= static_cast<int32_t>(i) || node.parent < SceneGraph::k_NoParent) {
+			offset = file_.size() + 1;
+			break;
+		}
+	}
+	if (offset > file_.size()) {
+		std::cout << "ERROR::MESHCACHE:: Corrupt node table in " << cachePath_ << std::endl;
+		file_.close();
+		return false;
+	}
+	return true;
+}
+
+uint32_t MeshCache::meshCount() const {
+	if (!file_.data()) return 0;
+	return reinterpret_cast<const FileHeader*>(file_.data())->meshCount;
+}
+
+MeshView MeshCache::mesh(const uint32_t index) const {
+	const MeshEntry& entry = reinterpret_cast<const MeshEntry*>(file_.data() + sizeof(FileHeader))[index];
+
+	MeshView mesh;
+	mesh.vertices = reinterpret_cast<const Vertex*>(file_.data() + entry.vertexOffset);
+	mesh.numVertices = entry.numVertices;
+	mesh.indices = reinterpret_cast<const uint32_t*>(file_.data() + entry.indexOffset);
+	mesh.numIndices = entry.numIndices;
+	mesh.lods = reinterpret_cast<const MeshLod*>(file_.data() + entry.lodOffset);
+	mesh.numLods = entry.numLods;
+
+	const uint8_t* cursor = file_.data() + entry.textureOffset;
+	const uint8_t* end = file_.data() + file_.size();
+	for (uint32_t i = 0; i < entry.numTextures; i++) {
+		uint32_t lengths[2];
+		if (cursor + sizeof(lengths) > end) break;
+		std::memcpy(lengths, cursor, sizeof(lengths));
+		cursor += sizeof(lengths);
+		if (cursor + lengths[0] + lengths[1] > end) break;
+
+		Texture texture;
+		texture.id = 0;
+		texture.type.assign(reinterpret_cast<const char*>(cursor), lengths[0]);
+		texture.path.assign(reinterpret_cast<const char*>(cursor) + lengths[0], lengths[1]);
+		cursor += align(lengths[0] + lengths[1], 4);
+		mesh.textures.push_back(texture);
+	}
+	return mesh;
+}
+
+void MeshCache::scene(SceneGraph* scene) const {
+	scene->clear();
+	if (!file_.data()) return;
+	const FileHeader* header = reinterpret_cast<const FileHeader*>(file_.data());
+	const uint8_t* cursor = file_.data() + header->sceneOffset;
+	for (uint32_t i = 0; i < header->nodeCount; i++) {
+		NodeEntry entry;
+		std::memcpy(&entry, cursor, sizeof(entry));
+		cursor += sizeof(entry);
+		const uint8_t* draws = cursor;
+		cursor += entry.numDraws * sizeof(uint32_t);
+		const uint32_t node = scene->addNode(std::string(reinterpret_cast<const char*>(cursor), entry.nameLength), entry.parent, entry.local);
+		cursor += align(entry.nameLength, 4);
+		for (uint32_t d = 0; d < entry.numDraws; d++) {
+			uint32_t mesh;
+			std::memcpy(&mesh, draws + d * sizeof(uint32_t), sizeof(mesh));
+			if (mesh < header->meshCount) scene->addDraw(node, mesh);
+		}
+	}
+}
+
+bool MeshCache::write(const std::vector<MeshData>& meshes, const SceneGraph& scene) const {
+	if (sourceHash_ == 0) return false;
+
+	// Lay out the file: header, mesh table, then texture table, vertices, indices and LOD table of each mesh,
+	// then the node table
+	std::vector<MeshEntry> entries(meshes.size());
+	size_t offset = sizeof(FileHeader) + entries.size() * sizeof(MeshEntry);
+	for (size_t i = 0; i < meshes.size(); i++) {
+		MeshEntry& entry = entries[i];
+		entry.textureOffset = offset;
+		entry.numTextures = static_cast<uint32_t>(meshes[i].textures.size());
+		for (const Texture& texture : meshes[i].textures) {
+			offset += 2 * sizeof(uint32_t) + align(texture.type.size() + texture.path.size(), 4);
+		}
+		offset = align(offset, 16);
+		entry.vertexOffset = offset;
+		entry.numVertices = static_cast<uint32_t>(meshes[i].vertices.size());
+		offset += meshes[i].vertices.size() * sizeof(Vertex);
+		offset = align(offset, 4);
+		entry.indexOffset = offset;
+		entry.numIndices = static_cast<uint32_t>(meshes[i].indices.size());
+		offset += meshes[i].indices.size() * sizeof(uint32_t);
+		entry.lodOffset = offset;
+		entry.numLods = static_cast<uint32_t>(meshes[i].lods.size());
+		offset += meshes[i].lods.size() * sizeof(MeshLod);
+	}
+	const size_t sceneOffset = align(offset, 16);
+
+	// Meshes drawn by each node
+	std::vector<std::vector<uint32_t>> nodeDraws(scene.size());
+	for (const SceneDraw& draw : scene.draws())
+		nodeDraws[draw.node].push_back(draw.mesh);
+
+	const std::string tmpPath = cachePath_ + ".tmp";
+	std::ofstream out(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+	if (!out) {
+		std::cout << "ERROR::MESHCACHE:: Could not write " << tmpPath << std::endl;
+		return false;
+	}
+
+	FileHeader header;
+	std::memcpy(header.magic, k_Magic, sizeof(k_Magic));
+	header.version = k_Version;
+	header.sourceHash = sourceHash_;
+	header.importFlags = importFlags_;
+	header.vertexSize = sizeof(Vertex);
+	header.meshCount = static_cast<uint32_t>(meshes.size());
+	header.nodeCount = scene.size();
+	header.sceneOffset = sceneOffset;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (!entries.empty())
+		out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(MeshEntry));
+
+	size_t written = sizeof(FileHeader) + entries.size() * sizeof(MeshEntry);
+	for (const MeshData& mesh : meshes) {
+		for (const Texture& texture : mesh.textures) {
+			const uint32_t lengths[2] = {
+				static_cast<uint32_t>(texture.type.size()),
+				static_cast<uint32_t>(texture.path.size())
+			};
+			out.write(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+			out.write(texture.type.data(), texture.type.size());
+			out.write(texture.path.data(), texture.path.size());
+			written += sizeof(lengths) + texture.type.size() + texture.path.size();
+			writePadding(out, written, 4);
+		}
+		writePadding(out, written, 16);
+		if (!mesh.vertices.empty())
+			out.write(reinterpret_cast<const char*>(mesh.vertices.data()), mesh.vertices.size() * sizeof(Vertex));
+		written += mesh.vertices.size() * sizeof(Vertex);
+		writePadding(out, written, 4);
+		if (!mesh.indices.empty())
+			out.write(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size() * sizeof(uint32_t));
+		written += mesh.indices.size() * sizeof(uint32_t);
+		if (!mesh.lods.empty())
+			out.write(reinterpret_cast<const char*>(mesh.lods.data()), mesh.lods.size() * sizeof(MeshLod));
+		written += mesh.lods.size() * sizeof(MeshLod);
+	}
+	writePadding(out, written, 16);
+	for (uint32_t i = 0; i < scene.size(); i++) {
+		NodeEntry entry;
+		entry.parent = scene.parent(i);
+		entry.numDraws = static_cast<uint32_t>(nodeDraws[i].size());
+		entry.nameLength = static_cast<uint32_t>(scene.name(i).size());
+		entry.pad = 0;
+		entry.local = scene.local(i);
+		out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+		if (!nodeDraws[i].empty())
+			out.write(reinterpret_cast<const char*>(nodeDraws[i].data()), nodeDraws[i].size() * sizeof(uint32_t));
+		out.write(scene.name(i).data(), scene.name(i).size());
+		written += sizeof(entry) + nodeDraws[i].size() * sizeof(uint32_t) + scene.name(i).size();
+		writePadding(out, written, 4);
+	}
+	out.close();
+	if (!out) {
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+
+	// Replace the previous cache only once the new one is complete
+	std::remove(cachePath_.c_str());
+	return std::rename(tmpPath.c_str(), cachePath_.c_str()) == 0;
+}
@@ -0,0 +1,293 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+	// Vertex scoring of Forsyth's algorithm
+	const uint32_t k_ScoringCacheSize = 32;
+	const float k_CacheDecayPower = 1.5f;
+	const float k_LastTriangleScore = 0.75f;
+	const float k_ValenceBoostScale = 2.0f;
+	const float k_ValenceBoostPower = 0.5f;
+
+	const uint32_t k_SimulatedCacheSize = 16;
+
+	struct VertexKey {
+		const Vertex* vertex;
+
+		bool operator==(const VertexKey& other) const {
+			return std::memcmp(vertex, other.vertex, sizeof(Vertex)) == 0;
+		}
+	};
+
+	struct VertexKeyHash {
+		size_t operator()(const VertexKey& key) const {
+			const uint8_t* data = reinterpret_cast<const uint8_t*>(key.vertex);
+			uint64_t hash = 14695981039346656037ULL;
+			for (size_t i = 0; i < sizeof(Vertex); i++) {
+				hash ^= data[i];
+				hash *= 1099511628211ULL;
+			}
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	float vertexScore(const int32_t cachePosition, const uint32_t remainingTriangles) {
+		if (remainingTriangles == 0) return -1.0f; // nothing left to draw with this vertex
+
+		float score = 0.0f;
+		if (cachePosition >= 0) {
+			if (cachePosition < 3) // used by the last triangle, fixed score to avoid ping-ponging
+				score = k_LastTriangleScore;
+			else
+				score = std::pow(1.0f - float(cachePosition - 3) / float(k_ScoringCacheSize - 3), k_CacheDecayPower);
+		}
+		// Finish off vertices with few triangles left before they drop out of the cache
+		return score + k_ValenceBoostScale * std::pow(float(remainingTriangles), -k_ValenceBoostPower);
+	}
+
+	uint32_t countReferenced(const uint32_t* indices, const size_t numIndices, const size_t numVertices) {
+		std::vector<bool> used(numVertices, false);
+		uint32_t count = 0;
+		for (size_t i = 0; i < numIndices; i++) {
+			if (!used[indices[i]]) {
+				used[indices[i]] = true;
+				count++;
+			}
+		}
+		return count;
+	}
+}
+
+VertexCacheStats analyzeVertexCache(const uint32_t* indices, const size_t numIndices,
+	const size_t numVertices, const uint32_t cacheSize) {
+	VertexCacheStats stats = { 0.0f, 0.0f };
+	if (numIndices < 3) return stats;
+
+	// FIFO cache: a vertex is resident while fewer than cacheSize misses happened since it was loaded
+	std::vector<uint32_t> loadedAt(numVertices, 0);
+	uint32_t misses = 0;
+	for (size_t i = 0; i < numIndices; i++) {
+		const uint32_t index = indices[i];
+		if (loadedAt[index] == 0 || misses - (loadedAt[index] - 1) >= cacheSize) {
+			misses++;
+			loadedAt[index] = misses;
+		}
+	}
+	stats.acmr = float(misses) / (numIndices / 3);
+	stats.atvr = float(misses) / countReferenced(indices, numIndices, numVertices);
+	return stats;
+}
+
+void weldVertices(MeshData& mesh) {
+	std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+	unique.reserve(mesh.vertices.size());
+
+	std::vector<uint32_t> remap(mesh.vertices.size());
+	uint32_t count = 0;
+	for (size_t i = 0; i < mesh.vertices.size(); i++) {
+		// Unique vertices are compacted in place, always at or before i, so keys stay valid
+		const VertexKey key = { &mesh.vertices[i] };
+		auto found = unique.find(key);
+		if (found != unique.end()) {
+			remap[i] = found->second;
+			continue;
+		}
+		if (count != i) mesh.vertices[count] = mesh.vertices[i];
+		unique.emplace(VertexKey{ &mesh.vertices[count] }, count);
+		remap[i] = count++;
+	}
+	mesh.vertices.resize(count);
+	for (uint32_t& index : mesh.indices)
+		index = remap[index];
+}
+
+void optimizeVertexCache(uint32_t* indices, const size_t numIndices, const size_t numVertices) {
+	const size_t numTriangles = numIndices / 3;
+	if (numTriangles == 0) return;
+
+	// Triangles of each vertex. The first remaining[v] entries are the ones not drawn yet.
+	std::vector<uint32_t> offsets(numVertices + 1, 0);
+	for (size_t i = 0; i < numIndices; i++)
+		offsets[indices[i] + 1]++;
+	for (size_t v = 0; v < numVertices; v++)
+		offsets[v + 1] += offsets[v];
+	std::vector<uint32_t> adjacency(numIndices);
+	std::vector<uint32_t> remaining(numVertices, 0);
+	for (size_t i = 0; i < numIndices; i++) {
+		const uint32_t v = indices[i];
+		adjacency[offsets[v] + remaining[v]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	std::vector<int32_t> cachePosition(numVertices, -1);
+	std::vector<float> score(numVertices);
+	for (size_t v = 0; v < numVertices; v++)
+		score[v] = vertexScore(-1, remaining[v]);
+	std::vector<float> triangleScore(numTriangles);
+	for (size_t t = 0; t < numTriangles; t++)
+		triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+
+	std::vector<bool> emitted(numTriangles, false);
+	std::vector<uint32_t> result;
+	result.reserve(numIndices);
+	std::vector<uint32_t> cache, nextCache;
+	size_t cursor = 0; // first triangle that may not have been emitted yet
+	int64_t best = -1;
+	while (result.size() < numIndices) {
+		if (best < 0) { // nothing adjacent to the cache, restart from the next undrawn triangle
+			while (emitted[cursor]) cursor++;
+			best = static_cast<int64_t>(cursor);
+		}
+
+		const uint32_t* triangle = indices + best * 3;
+		emitted[best] = true;
+		for (uint32_t k = 0; k < 3; k++) {
+			const uint32_t v = triangle[k];
+			result.push_back(v);
+			uint32_t* begin = &adjacency[offsets[v]];
+			uint32_t* end = begin + remaining[v];
+			uint32_t* found = std::find(begin, end, static_cast<uint32_t>(best));
+			if (found != end) {
+				std::swap(*found, *(end - 1));
+				remaining[v]--;
+			}
+		}
+
+		// Triangle vertices move to the front of the LRU cache
+		nextCache.assign(result.end() - 3, result.end());
+		for (uint32_t v : cache)
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+				nextCache.push_back(v);
+		for (size_t i = 0; i < nextCache.size(); i++) {
+			const uint32_t v = nextCache[i];
+			cachePosition[v] = i < k_ScoringCacheSize ? static_cast<int32_t>(i) : -1;
+			const float updated = vertexScore(cachePosition[v], remaining[v]);
+			const float delta = updated - score[v];
+			score[v] = updated;
+			for (uint32_t j = 0; j < remaining[v]; j++)
+				triangleScore[adjacency[offsets[v] + j]] += delta;
+		}
+		if (nextCache.size() > k_ScoringCacheSize) nextCache.resize(k_ScoringCacheSize);
+		cache.swap(nextCache);
+
+		// Next triangle: the best one still touching the cache
+		best = -1;
+		float bestScore = -1.0f;
+		for (uint32_t v : cache) {
+			for (uint32_t j = 0; j < remaining[v]; j++) {
+				const uint32_t t = adjacency[offsets[v] + j];
+				if (triangleScore[t] > bestScore) {
+					bestScore = triangleScore[t];
+					best = t;
+				}
+			}
+		}
+	}
+	std::copy(result.begin(), result.end(), indices);
+}
+
+void optimizeOverdraw(uint32_t* indices, const size_t numIndices, const Vertex* vertices,
+	const size_t numVertices, const float threshold) {
+	const size_t numTriangles = numIndices / 3;
+	if (numTriangles < 2) return;
+
+	// Clusters start wherever the cache order jumps: a triangle missing all three vertices
+	std::vector<uint32_t> clusterStart;
+	std::vector<uint32_t> loadedAt(numVertices, 0);
+	uint32_t misses = 0;
+	for (size_t t = 0; t < numTriangles; t++) {
+		uint32_t triangleMisses = 0;
+		for (uint32_t k = 0; k < 3; k++) {
+			const uint32_t index = indices[t * 3 + k];
+			if (loadedAt[index] == 0 || misses - (loadedAt[index] - 1) >= k_SimulatedCacheSize) {
+				misses++;
+				triangleMisses++;
+				loadedAt[index] = misses;
+			}
+		}
+		if (t == 0 || triangleMisses == 3) clusterStart.push_back(static_cast<uint32_t>(t));
+	}
+	if (clusterStart.size() < 2) return;
+	clusterStart.push_back(static_cast<uint32_t>(numTriangles));
+
+	// Sort key: how far a cluster sits along its own normal from the mesh centroid.
+	// Clusters on the outside facing away from the centre are likely to occlude the rest.
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+	const size_t numClusters = clusterStart.size() - 1;
+	std::vector<glm::vec3> centroids(numClusters, glm::vec3(0.0f));
+	std::vector<glm::vec3> normals(numClusters, glm::vec3(0.0f));
+	for (size_t c = 0; c < numClusters; c++) {
+		float area = 0.0f;
+		for (uint32_t t = clusterStart[c]; t < clusterStart[c + 1]; t++) {
+			const glm::vec3& a = vertices[indices[t * 3]].Position;
+			const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+			const glm::vec3& d = vertices[indices[t * 3 + 2]].Position;
+			const glm::vec3 normal = glm::cross(b - a, d - a); // length is twice the area
+			const float weight = glm::length(normal);
+			centroids[c] += (a + b + d) * (weight / 3.0f);
+			normals[c] += normal;
+			area += weight;
+		}
+		meshCentroid += centroids[c];
+		meshArea += area;
+		centroids[c] = area > 0.0f ? centroids[c] / area : vertices[indices[clusterStart[c] * 3]].Position;
+	}
+	if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+	std::vector<float> sortKey(numClusters);
+	std::vector<uint32_t> order(numClusters);
+	for (size_t c = 0; c < numClusters; c++) {
+		const float length = glm::length(normals[c]);
+		sortKey[c] = length > 0.0f ? glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+		order[c] = static_cast<uint32_t>(c);
+	}
+	std::stable_sort(order.begin(), order.end(), [&sortKey](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+	std::vector<uint32_t> result;
+	result.reserve(numIndices);
+	for (uint32_t c : order)
+		result.insert(result.end(), indices + clusterStart[c] * 3, indices + clusterStart[c + 1] * 3);
+
+	const float before = analyzeVertexCache(indices, numIndices, numVertices, k_SimulatedCacheSize).acmr;
+	const float after = analyzeVertexCache(result.data(), result.size(), numVertices, k_SimulatedCacheSize).acmr;
+	if (after <= before * threshold)
+		std::copy(result.begin(), result.end(), indices);
+}
+
+void optimizeVertexFetch(MeshData& mesh) {
+	const uint32_t unused = ~0u;
+	std::vector<uint32_t> remap(mesh.vertices.size(), unused);
+	std::vector<Vertex> vertices;
+	vertices.reserve(mesh.vertices.size());
+	for (uint32_t& index : mesh.indices) {
+		if (remap[index] == unused) {
+			remap[index] = static_cast<uint32_t>(vertices.size());
+			vertices.push_back(mesh.vertices[index]);
+		}
+		index = remap[index];
+	}
+	mesh.vertices.swap(vertices);
+}
+
+void optimizeMesh(MeshData& mesh, MeshOptimizationStats* stats) {
+	if (stats) {
+		stats->verticesBefore = static_cast<uint32_t>(mesh.vertices.size());
+		stats->numTriangles = static_cast<uint32_t>(mesh.indices.size() / 3);
+		stats->before = analyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+	}
+
+	weldVertices(mesh);
+	optimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+	optimizeOverdraw(mesh.indices.data(), mesh.indices.size(), mesh.vertices.data(), mesh.vertices.size());
+	optimizeVertexFetch(mesh);
+
+	if (stats) {
+		stats->verticesAfter = static_cast<uint32_t>(mesh.vertices.size());
+		stats->indexSize = indexSize(mesh.vertices.size());
+		stats->after = analyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+	}
+}
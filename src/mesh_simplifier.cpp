@@ -0,0 +1,189 @@
+#include "mesh_simplifier.h"
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+	// Sum of squared distances to a set of planes, weighted by triangle area
+	struct Quadric {
+		double a00, a11, a22, a10, a20, a21;
+		double b0, b1, b2;
+		double c;
+		double weight;
+	};
+
+	struct Collapse {
+		uint32_t from, to;
+		float cost;
+	};
+
+	Quadric planeQuadric(const glm::vec3& normal, const float distance, const double weight) {
+		const double a = normal.x, b = normal.y, c = normal.z, d = distance;
+		Quadric q;
+		q.a00 = a * a * weight; q.a11 = b * b * weight; q.a22 = c * c * weight;
+		q.a10 = a * b * weight; q.a20 = a * c * weight; q.a21 = b * c * weight;
+		q.b0 = a * d * weight; q.b1 = b * d * weight; q.b2 = c * d * weight;
+		q.c = d * d * weight;
+		q.weight = weight;
+		return q;
+	}
+
+	void addQuadric(Quadric& q, const Quadric& other) {
+		q.a00 += other.a00; q.a11 += other.a11; q.a22 += other.a22;
+		q.a10 += other.a10; q.a20 += other.a20; q.a21 += other.a21;
+		q.b0 += other.b0; q.b1 += other.b1; q.b2 += other.b2;
+		q.c += other.c;
+		q.weight += other.weight;
+	}
+
+	// Mean squared distance of p to the planes of q
+	float quadricError(const Quadric& q, const glm::vec3& p) {
+		const double x = p.x, y = p.y, z = p.z;
+		const double rx = q.a00 * x + q.a10 * y + q.a20 * z + q.b0;
+		const double ry = q.a10 * x + q.a11 * y + q.a21 * z + q.b1;
+		const double rz = q.a20 * x + q.a21 * y + q.a22 * z + q.b2;
+		const double error = rx * x + ry * y + rz * z + q.b0 * x + q.b1 * y + q.b2 * z + q.c;
+		return q.weight > 0.0 ? static_cast<float>(std::max(error, 0.0) / q.weight) : 0.0f;
+	}
+
+	uint64_t edgeKey(const uint32_t a, const uint32_t b) {
+		return (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+	}
+
+	// Whether moving vertex from to the position of to flips or folds any triangle around it
+	bool flipsTriangles(const Vertex* vertices, const std::vector<uint32_t>& indices,
+		const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& adjacency,
+		const uint32_t from, const uint32_t to) {
+		const glm::vec3& target = vertices[to].Position;
+		for (uint32_t j = offsets[from]; j < offsets[from + 1]; j++) {
+			const uint32_t* triangle = &indices[adjacency[j] * 3];
+			if (triangle[0] == to || triangle[1] == to || triangle[2] == to) continue; // collapses away
+
+			glm::vec3 before[3], after[3];
+			for (uint32_t k = 0; k < 3; k++) {
+				before[k] = vertices[triangle[k]].Position;
+				after[k] = triangle[k] == from ? target : before[k];
+			}
+			const glm::vec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+			const glm::vec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+			if (glm::dot(n0, n1) <= 0.25f * glm::length(n0) * glm::length(n1)) return true;
+		}
+		return false;
+	}
+}
+
+std::vector<uint32_t> simplifyIndices(const Vertex* vertices, const size_t numVertices,
+	const uint32_t* indices, const size_t numIndices, const size_t targetIndices, float* error) {
+	std::vector<uint32_t> result(indices, indices + numIndices);
+	float maxError = 0.0f;
+
+	// Open edges have a single triangle. Their vertices stay put so silhouettes and seams hold.
+	std::unordered_map<uint64_t, uint32_t> edgeUses;
+	for (size_t i = 0; i < numIndices; i += 3)
+		for (uint32_t k = 0; k < 3; k++)
+			edgeUses[edgeKey(indices[i + k], indices[i + (k + 1) % 3])]++;
+	std::vector<bool> locked(numVertices, false);
+	for (size_t i = 0; i < numIndices; i += 3) {
+		for (uint32_t k = 0; k < 3; k++) {
+			const uint32_t a = indices[i + k], b = indices[i + (k + 1) % 3];
+			if (edgeUses[edgeKey(a, b)] == 1) locked[a] = locked[b] = true;
+		}
+	}
+
+	std::vector<Quadric> quadrics(numVertices, planeQuadric(glm::vec3(0.0f), 0.0f, 0.0));
+	for (size_t i = 0; i < numIndices; i += 3) {
+		const glm::vec3& p0 = vertices[indices[i]].Position;
+		const glm::vec3 normal = glm::cross(vertices[indices[i + 1]].Position - p0, vertices[indices[i + 2]].Position - p0);
+		const float area = glm::length(normal);
+		if (area <= 0.0f) continue;
+		const glm::vec3 unit = normal / area;
+		const Quadric q = planeQuadric(unit, -glm::dot(unit, p0), area);
+		for (uint32_t k = 0; k < 3; k++)
+			addQuadric(quadrics[indices[i + k]], q);
+	}
+
+	// Passes of independent collapses, cheapest first, until the target is met
+	std::vector<uint32_t> offsets, adjacency;
+	std::vector<Collapse> collapses;
+	std::vector<uint32_t> remap(numVertices);
+	std::vector<bool> touched(numVertices);
+	while (result.size() > targetIndices) {
+		offsets.assign(numVertices + 1, 0);
+		for (uint32_t index : result) offsets[index + 1]++;
+		for (size_t v = 0; v < numVertices; v++) offsets[v + 1] += offsets[v];
+		adjacency.resize(result.size());
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < result.size(); i++)
+			adjacency[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+
+		collapses.clear();
+		for (size_t i = 0; i < result.size(); i += 3) {
+			for (uint32_t k = 0; k < 3; k++) {
+				const uint32_t a = result[i + k], b = result[i + (k + 1) % 3];
+				Quadric merged = quadrics[a];
+				addQuadric(merged, quadrics[b]);
+				if (!locked[a]) collapses.push_back({ a, b, quadricError(merged, vertices[b].Position) });
+				if (!locked[b]) collapses.push_back({ b, a, quadricError(merged, vertices[a].Position) });
+			}
+		}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+		// Each collapse removes about two triangles
+		const size_t wanted = (result.size() - targetIndices) / 6 + 1;
+		size_t performed = 0;
+		for (size_t v = 0; v < numVertices; v++) remap[v] = static_cast<uint32_t>(v);
+		std::fill(touched.begin(), touched.end(), false);
+		for (const Collapse& collapse : collapses) {
+			if (performed >= wanted) break;
+			if (touched[collapse.from] || touched[collapse.to]) continue;
+			if (flipsTriangles(vertices, result, offsets, adjacency, collapse.from, collapse.to)) continue;
+
+			remap[collapse.from] = collapse.to;
+			addQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+			// Neighbouring triangles changed shape, keep them out of this pass's flip checks
+			for (uint32_t j = offsets[collapse.from]; j < offsets[collapse.from + 1]; j++)
+				for (uint32_t k = 0; k < 3; k++)
+					touched[result[adjacency[j] * 3 + k]] = true;
+			maxError = std::max(maxError, collapse.cost);
+			performed++;
+		}
+		if (performed == 0) break;
+
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3) {
+			const uint32_t a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+			if (a == b || b == c || a == c) continue;
+			result[write++] = a;
+			result[write++] = b;
+			result[write++] = c;
+		}
+		result.resize(write);
+	}
+
+	if (error) *error = std::sqrt(maxError);
+	return result;
+}
+
+void generateLods(MeshData& mesh, const uint32_t maxLods) {
+	mesh.lods.clear();
+	mesh.lods.push_back({ 0, static_cast<uint32_t>(mesh.indices.size()), 0.0f });
+
+	float error = 0.0f;
+	while (mesh.lods.size() < maxLods) {
+		const MeshLod previous = mesh.lods.back();
+		const size_t target = previous.numIndices / 6 * 3;
+		if (target < 3) break;
+
+		float levelError = 0.0f;
+		std::vector<uint32_t> level = simplifyIndices(mesh.vertices.data(), mesh.vertices.size(),
+			mesh.indices.data() + previous.firstIndex, previous.numIndices, target, &levelError);
+		if (level.size() > previous.numIndices * 0.85f) break; // mostly locked, not worth another level
+
+		optimizeVertexCache(level.data(), level.size(), mesh.vertices.size());
+		error += levelError; // each level simplifies the previous one, so deviations add up
+		mesh.lods.push_back({ static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(level.size()), error });
+		mesh.indices.insert(mesh.indices.end(), level.begin(), level.end());
+	}
+}
@@ -2,45 +2,674 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
-#include <stb_image.h>
 #include <glad/glad.h>
 
 #include "model.h"
+#include "camera.h"
+#include "frustum_cull.h"
+#include "gl_state.h"
+#include "mesh_cache.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "texture_cache.h"
+#include "texture_loader.h"
+#include "thread_pool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+// Post-processing applied on import. Part of the mesh cache key.
+static const uint32_t k_ImportFlags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static double elapsedMs(const Clock::time_point& start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Assimp matrices are row major
+static glm::mat4 toMat4(const aiMatrix4x4& m) {
+	return glm::mat4(m.a1, m.b1, m.c1, m.d1,
+		m.a2, m.b2, m.c2, m.d2,
+		m.a3, m.b3, m.c3, m.d3,
+		m.a4, m.b4, m.c4, m.d4);
+}
+
+// True when the nodes draw every mesh exactly once without a transform, so drawing
+// the meshes in order is the whole scene
+static bool isFlat(const SceneGraph& scene, const size_t numMeshes) {
+	if (scene.draws().size() != numMeshes) return false;
+	std::vector<uint8_t> drawn(numMeshes, 0);
+	for (const SceneDraw& draw : scene.draws()) {
+		if (draw.mesh >= numMeshes || drawn[draw.mesh]++) return false;
+		if (scene.world(draw.node) != glm::mat4(1.0f)) return false;
+	}
+	return true;
+}
+
+// Mesh processed by the loader thread, waiting for its GL upload
+struct PendingMesh {
+	MeshData data;
+	std::vector<std::string> keys; // texture cache key of each texture
+	std::vector<DecodedImage> images; // textures decoded for this mesh
+};
+
+// Texture decode queued on the shared pool for the async loader. Whoever claims it first
+// runs it, so the loader, itself a pool task, decodes the ones still queued instead of
+// waiting behind them.
+struct TextureDecode {
+	TextureDecode(const std::string& textureKey, const bool hash) : key(textureKey), hashContent(hash) {}
+
+	// False when it was already claimed
+	bool run() {
+		if (claimed.exchange(true)) return false;
+		promise.set_value(decodeImage(key, hashContent));
+		return true;
+	}
+	// Drops the image, stopping the decode when it has not started
+	void cancel() {
+		if (!claimed.exchange(true)) return;
+		DecodedImage image = result.get();
+		releaseImage(image);
+	}
+
+	std::string key;
+	bool hashContent;
+	std::atomic<bool> claimed{ false };
+	std::promise<DecodedImage> promise;
+	std::future<DecodedImage> result = promise.get_future();
+};
+
+// State shared between an asynchronously loading Model and its loader thread.
+// Only CPU data lives here, GL objects are created by Model::update.
+struct AsyncModelLoad {
+	std::mutex mutex;
+	std::deque<PendingMesh> ready;
+	std::vector<MeshOptimizationStats> optimizationStats; // set before finished
+	SceneGraph scene; // set before the first mesh, taken by the first update()
+	ModelLoadStats loadStats; // loader thread stages, set before finished
+	Clock::time_point start = Clock::now();
+	std::atomic<bool> finished{ false };
+
+	~AsyncModelLoad() {
+		for (PendingMesh& mesh : ready)
+			for (DecodedImage& image : mesh.images)
+				releaseImage(image);
+	}
+};
 
 Model::Model(std::string const &path, bool gamma) : gammaCorrection_(gamma) {
 	loadModel(path);
 }
 
+Model::Model(std::string const &path, const ModelOptions& options) :
+	gammaCorrection_(options.gamma),
+	options_(options)
+{
+	loadModel(path);
+}
+
+Model::Model(const std::vector<MeshData>& meshes, const ModelOptions& options) :
+	gammaCorrection_(options.gamma),
+	options_(options)
+{
+	const uint32_t root = scene_.addNode("root", SceneGraph::k_NoParent, glm::mat4(1.0f));
+	for (uint32_t i = 0; i < meshes.size(); i++)
+		scene_.addDraw(root, i);
+
+	std::vector<MeshView> views;
+	for (const MeshData& mesh : meshes)
+		views.push_back(viewOf(mesh));
+	createMeshes(views);
+}
+
+Model::~Model() {
+	if (!VAO_) return;
+	indirect_.reset();
+	GLState::instance().forgetVertexArray(VAO_);
+	glDeleteVertexArrays(1, &VAO_);
+	glDeleteBuffers(1, &VBO_);
+	glDeleteBuffers(1, &EBO_);
+}
+
+std::shared_ptr<Model> Model::loadAsync(std::string const &path, bool gamma) {
+	ModelOptions options;
+	options.gamma = gamma;
+	return loadAsync(path, options);
+}
+
+std::shared_ptr<Model> Model::loadAsync(std::string const &path, const ModelOptions& options) {
+	std::shared_ptr<Model> model(new Model());
+	model->gammaCorrection_ = options.gamma;
+	model->options_ = options;
+	model->directory_ = path.substr(0, path.find_last_of('/'));
+	model->async_ = std::make_shared<AsyncModelLoad>();
+
+	// The loader only keeps a weak reference, so it stops as soon as the model is destroyed
+	std::weak_ptr<AsyncModelLoad> load = model->async_;
+	const std::string directory = model->directory_;
+	const bool hashContent = TextureCache::instance().contentHashing();
+	ThreadPool::shared().submit([load, path, directory, hashContent]() {
+		ModelLoadStats stats;
+		std::vector<MeshData> meshes;
+		SceneGraph scene;
+		MeshCache cache(path, k_ImportFlags);
+		const Clock::time_point cacheStart = Clock::now();
+		stats.cacheHit = cache.load();
+		stats.cacheReadMs = elapsedMs(cacheStart);
+		std::vector<MeshOptimizationStats> optimization;
+		if (stats.cacheHit) {
+			for (uint32_t i = 0; i < cache.meshCount(); i++) {
+				const MeshView cached = cache.mesh(i);
+				MeshData data;
+				data.vertices.assign(cached.vertices, cached.vertices + cached.numVertices);
+				data.indices.assign(cached.indices, cached.indices + cached.numIndices);
+				data.textures = cached.textures;
+				data.lods.assign(cached.lods, cached.lods + cached.numLods);
+				meshes.push_back(std::move(data));
+			}
+			cache.scene(&scene);
+		}
+		else {
+			importMeshes(path, cache, &meshes, &scene, &optimization, &stats);
+		}
+
+		// The nodes go first, so streamed meshes are drawn at their nodes as they arrive
+		{
+			std::shared_ptr<AsyncModelLoad> target = load.lock();
+			if (!target) return;
+			std::lock_guard<std::mutex> lock(target->mutex);
+			target->scene = std::move(scene);
+		}
+
+		// Queue every texture that is not resident on the pool up front, each one owned
+		// by the first mesh that needs it
+		std::vector<std::vector<std::string>> meshKeys(meshes.size());
+		std::vector<std::vector<std::shared_ptr<TextureDecode>>> decodes(meshes.size());
+		std::unordered_set<std::string> requested;
+		for (uint32_t i = 0; i < meshes.size(); i++) {
+			for (const Texture& texture : meshes[i].textures) {
+				meshKeys[i].push_back(TextureCache::normalizePath(directory + '/' + texture.path));
+				const std::string& key = meshKeys[i].back();
+				if (!requested.insert(key).second) continue;
+				if (TextureCache::instance().find(key)) {
+					stats.texturesShared++;
+					continue;
+				}
+				std::shared_ptr<TextureDecode> decode = std::make_shared<TextureDecode>(key, hashContent);
+				ThreadPool::shared().submit([decode]() { decode->run(); });
+				decodes[i].push_back(decode);
+			}
+		}
+
+		// Hand meshes over in order, each once the textures it owns are decoded
+		for (uint32_t i = 0; i < meshes.size(); i++) {
+			PendingMesh pending;
+			pending.keys.swap(meshKeys[i]);
+			for (const std::shared_ptr<TextureDecode>& decode : decodes[i]) {
+				decode->run();
+				pending.images.push_back(decode->result.get());
+				stats.textureDecodeMs += pending.images.back().decodeMs;
+				stats.texturesDecoded++;
+			}
+			pending.data = std::move(meshes[i]);
+
+			std::shared_ptr<AsyncModelLoad> target = load.lock();
+			if (!target) {
+				for (DecodedImage& image : pending.images) releaseImage(image);
+				for (uint32_t j = i + 1; j < meshes.size(); j++)
+					for (const std::shared_ptr<TextureDecode>& decode : decodes[j]) decode->cancel();
+				return;
+			}
+			std::lock_guard<std::mutex> lock(target->mutex);
+			target->ready.push_back(std::move(pending));
+		}
+		if (std::shared_ptr<AsyncModelLoad> target = load.lock()) {
+			std::lock_guard<std::mutex> lock(target->mutex);
+			target->optimizationStats.swap(optimization);
+			target->loadStats = stats;
+			target->finished = true;
+		}
+	});
+	return model;
+}
+
+bool Model::update(const uint32_t maxMeshes) {
+	if (!async_) return false;
+
+	TextureCache& cache = TextureCache::instance();
+	if (scene_.empty()) {
+		std::lock_guard<std::mutex> lock(async_->mutex);
+		scene_ = std::move(async_->scene);
+	}
+	for (uint32_t count = 0; count < maxMeshes; count++) {
+		PendingMesh pending;
+		{
+			std::lock_guard<std::mutex> lock(async_->mutex);
+			if (async_->ready.empty()) break;
+			pending = std::move(async_->ready.front());
+			async_->ready.pop_front();
+		}
+
+		std::unordered_map<std::string, TextureHandle> uploaded; // textures first needed by this mesh
+		for (DecodedImage& image : pending.images) {
+			TextureTiming timing;
+			timing.path = image.path;
+			timing.decodeMs = image.decodeMs;
+			uploaded[image.path] = cache.insert(image.path, image, &timing.uploadMs, &timing.mipmapMs);
+			textureTimings_.push_back(timing);
+			loadStats_.textureUploadMs += timing.uploadMs;
+			loadStats_.mipmapMs += timing.mipmapMs;
+		}
+		for (uint32_t i = 0; i < pending.keys.size(); i++) {
+			Texture& texture = pending.data.textures[i];
+			auto found = streamedTextures_.find(pending.keys[i]);
+			const bool first = found == streamedTextures_.end();
+			if (first) { // first mesh using this texture
+				TextureHandle handle = uploaded.count(pending.keys[i]) ? uploaded[pending.keys[i]] : cache.find(pending.keys[i]);
+				if (!handle) { // released since the loader checked, load it here
+					DecodedImage image = decodeImage(pending.keys[i], cache.contentHashing());
+					loadStats_.textureDecodeMs += image.decodeMs;
+					loadStats_.texturesDecoded++;
+					double uploadMs = 0.0, mipmapMs = 0.0;
+					handle = cache.insert(pending.keys[i], image, &uploadMs, &mipmapMs);
+					loadStats_.textureUploadMs += uploadMs;
+					loadStats_.mipmapMs += mipmapMs;
+				}
+				found = streamedTextures_.emplace(pending.keys[i], handle).first;
+			}
+			texture.handle = found->second;
+			texture.id = found->second->id();
+			if (first) textures_loaded_.push_back(texture);
+		}
+		if (options_.storage == StorageMode::Consolidated) // shared buffers are built once at the end
+			streamedMeshes_.push_back(std::move(pending.data));
+		else {
+			const Clock::time_point uploadStart = Clock::now();
+			const uint32_t numVertices = static_cast<uint32_t>(pending.data.vertices.size());
+			const uint32_t numIndices = static_cast<uint32_t>(pending.data.indices.size());
+			meshes_.push_back(Mesh(std::move(pending.data), options_.vertexFormat, options_.cpuGeometry));
+			countMesh(meshes_.back(), numVertices, numIndices);
+			loadStats_.meshUploadMs += elapsedMs(uploadStart);
+		}
+	}
+
+	if (!async_->finished) return true;
+	{
+		std::lock_guard<std::mutex> lock(async_->mutex);
+		if (!async_->ready.empty()) return true;
+		optimizationStats_.swap(async_->optimizationStats);
+		loadStats_.add(async_->loadStats);
+	}
+	if (!streamedMeshes_.empty()) {
+		std::vector<MeshView> views;
+		for (const MeshData& mesh : streamedMeshes_)
+			views.push_back(viewOf(mesh));
+		createMeshes(views, &streamedMeshes_);
+		streamedMeshes_.clear();
+	}
+	streamedTextures_.clear();
+	loadStats_.totalMs = elapsedMs(async_->start);
+	async_.reset();
+	return false;
+}
+
+void ModelLoadStats::add(const ModelLoadStats& other) {
+	cacheHit = cacheHit || other.cacheHit;
+	totalMs += other.totalMs;
+	cacheReadMs += other.cacheReadMs;
+	parseMs += other.parseMs;
+	traverseMs += other.traverseMs;
+	convertMs += other.convertMs;
+	optimizeMs += other.optimizeMs;
+	lodMs += other.lodMs;
+	cacheWriteMs += other.cacheWriteMs;
+	textureDecodeMs += other.textureDecodeMs;
+	textureUploadMs += other.textureUploadMs;
+	mipmapMs += other.mipmapMs;
+	meshUploadMs += other.meshUploadMs;
+	meshes += other.meshes;
+	vertices += other.vertices;
+	indices += other.indices;
+	texturesDecoded += other.texturesDecoded;
+	texturesShared += other.texturesShared;
+	vertexBytes += other.vertexBytes;
+	indexBytes += other.indexBytes;
+}
+
+std::string ModelLoadStats::toJson() const {
+	std::ostringstream json;
+	json << "{\n"
+		<< "  \"cacheHit\": " << (cacheHit ? "true" : "false") << ",\n"
+		<< "  \"totalMs\": " << totalMs << ",\n"
+		<< "  \"stagesMs\": {\n"
+		<< "    \"cacheRead\": " << cacheReadMs << ",\n"
+		<< "    \"parse\": " << parseMs << ",\n"
+		<< "    \"traverse\": " << traverseMs << ",\n"
+		<< "    \"convert\": " << convertMs << ",\n"
+		<< "    \"optimize\": " << optimizeMs << ",\n"
+		<< "    \"lod\": " << lodMs << ",\n"
+		<< "    \"cacheWrite\": " << cacheWriteMs << ",\n"
+		<< "    \"textureDecode\": " << textureDecodeMs << ",\n"
+		<< "    \"textureUpload\": " << textureUploadMs << ",\n"
+		<< "    \"mipmap\": " << mipmapMs << ",\n"
+		<< "    \"meshUpload\": " << meshUploadMs << "\n"
+		<< "  },\n"
+		<< "  \"counters\": {\n"
+		<< "    \"meshes\": " << meshes << ",\n"
+		<< "    \"vertices\": " << vertices << ",\n"
+		<< "    \"indices\": " << indices << ",\n"
+		<< "    \"texturesDecoded\": " << texturesDecoded << ",\n"
+		<< "    \"texturesShared\": " << texturesShared << ",\n"
+		<< "    \"vertexBytes\": " << vertexBytes << ",\n"
+		<< "    \"indexBytes\": " << indexBytes << "\n"
+		<< "  }\n"
+		<< "}\n";
+	return json.str();
+}
+
+void Model::releaseCpuGeometry(const CpuGeometry cpu) {
+	for (Mesh& mesh : meshes_)
+		mesh.releaseCpuGeometry(cpu);
+}
+
+size_t Model::cpuBytes() const {
+	size_t bytes = 0;
+	for (const Mesh& mesh : meshes_)
+		bytes += mesh.cpuBytes();
+	for (const MeshData& mesh : streamedMeshes_)
+		bytes += mesh.vertices.capacity() * sizeof(Vertex) + mesh.indices.capacity() * sizeof(uint32_t);
+	return bytes;
+}
+
+bool Model::isLoaded() const {
+	return !async_;
+}
+
 void Model::Draw(const Shader& shader) const {
-	for (uint32_t i = 0; i < meshes_.size(); i++)
-		meshes_[i].Draw(shader);
+	if (indirect_) { // one call per material at most
+		indirect_->draw(shader, meshes_);
+		return;
+	}
+	const bool consolidated = options_.storage == StorageMode::Consolidated;
+	if (consolidated) GLState::instance().bindVertexArray(VAO_); // one VAO bind for the whole model
+	for (const SceneDraw& draw : scene_.draws()) {
+		if (draw.mesh >= meshes_.size()) continue; // still streaming in
+		const Mesh& mesh = meshes_[draw.mesh];
+		if (!consolidated) {
+			mesh.Draw(shader);
+			continue;
+		}
+		mesh.bind(shader);
+		mesh.drawElements();
+	}
+}
+
+void Model::Draw(const Shader& shader, const glm::mat4& model) const {
+	static const UniformName k_Model("model");
+	static const UniformName k_NormalMat("normalMat");
+	const UniformHandle modelHandle = shader.uniform(k_Model);
+	const UniformHandle normalMat = shader.uniform(k_NormalMat);
+
+	const bool consolidated = options_.storage == StorageMode::Consolidated;
+	GLState& glState = GLState::instance();
+	if (consolidated) glState.bindVertexArray(VAO_);
+	for (const SceneDraw& draw : scene_.draws()) {
+		if (draw.mesh >= meshes_.size()) continue; // still streaming in
+		const Mesh& mesh = meshes_[draw.mesh];
+		const glm::mat4 world = model * scene_.world(draw.node);
+		shader.set(modelHandle, world);
+		if (normalMat.slot >= 0)
+			shader.set(normalMat, glm::inverse(glm::transpose(glm::mat3(world))));
+		mesh.bind(shader);
+		if (!consolidated) glState.bindVertexArray(mesh.VAO_);
+		mesh.drawElements();
+	}
+}
+
+void Model::Draw(const Shader& shader, const Camera& camera, const glm::mat4& model,
+	const LodSettings& settings, LodState* state) const {
+	static const UniformName k_Model("model");
+	static const UniformName k_NormalMat("normalMat");
+	const UniformHandle modelHandle = shader.uniform(k_Model);
+	const UniformHandle normalMat = shader.uniform(k_NormalMat);
+
+	// Pixels covered by one unit at distance 1
+	const float pixelsPerUnit = settings.viewportHeight / (2.0f * std::tan(glm::radians(camera.getFOV()) * 0.5f));
+	const glm::vec3 eye = camera.getPosition();
+	const std::vector<SceneDraw>& draws = scene_.draws();
+	if (state) state->levels.resize(draws.size(), 0);
+
+	const bool consolidated = options_.storage == StorageMode::Consolidated;
+	GLState& glState = GLState::instance();
+	if (consolidated) glState.bindVertexArray(VAO_);
+	for (uint32_t i = 0; i < draws.size(); i++) {
+		if (draws[i].mesh >= meshes_.size()) continue; // still streaming in
+		const Mesh& mesh = meshes_[draws[i].mesh];
+		const glm::mat4 world = model * scene_.world(draws[i].node);
+		// Object-space error that projects to settings.pixelError at distance 1
+		const float scale = std::max(glm::length(glm::vec3(world[0])), std::max(glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2]))));
+		const float errorAtUnitDistance = settings.pixelError / (pixelsPerUnit * scale);
+		const glm::vec3 center = glm::vec3(world * glm::vec4(mesh.boundsCenter_, 1.0f));
+		const float distance = std::max(glm::length(center - eye) - mesh.boundsRadius_ * scale, 1e-3f);
+		const uint32_t lod = mesh.selectLod(errorAtUnitDistance * distance,
+			state ? state->levels[i] : 0, state ? settings.hysteresis : 0.0f);
+		if (state) state->levels[i] = lod;
+
+		shader.set(modelHandle, world);
+		if (normalMat.slot >= 0)
+			shader.set(normalMat, glm::inverse(glm::transpose(glm::mat3(world))));
+		mesh.bind(shader);
+		if (!consolidated) glState.bindVertexArray(mesh.VAO_);
+		mesh.drawElements(lod);
+	}
+}
+
+void Model::enqueue(RenderQueue& queue, const Shader& shader, const glm::mat4& model, const RenderPass pass,
+	const Frustum* frustum) const {
+	const std::vector<SceneDraw>& draws = scene_.draws();
+	if (!frustum) {
+		for (const SceneDraw& draw : draws) {
+			if (draw.mesh < meshes_.size())
+				queue.enqueue(shader, meshes_[draw.mesh], model * scene_.world(draw.node), pass);
+		}
+		return;
+	}
+
+	cullBounds_.clear();
+	cullResident_.clear();
+	cullVisible_.clear();
+	for (uint32_t i = 0; i < draws.size(); i++) {
+		if (draws[i].mesh >= meshes_.size()) continue;
+		cullBounds_.add(meshes_[draws[i].mesh], model * scene_.world(draws[i].node));
+		cullResident_.push_back(i);
+	}
+	cullBounds(*frustum, cullBounds_, &cullVisible_);
+	for (const uint32_t i : cullVisible_) {
+		const SceneDraw& draw = draws[cullResident_[i]];
+		queue.enqueue(shader, meshes_[draw.mesh], model * scene_.world(draw.node), pass);
+	}
+}
+
+void Model::countMesh(const Mesh& mesh, const uint32_t numVertices, const uint32_t numIndices) {
+	loadStats_.meshes++;
+	loadStats_.vertices += numVertices;
+	loadStats_.indices += numIndices;
+	loadStats_.vertexBytes += uint64_t(numVertices) * vertexStride(mesh.format_);
+	loadStats_.indexBytes += uint64_t(numIndices) * mesh.indexSize_;
+}
+
+void Model::createMeshes(const std::vector<MeshView>& views, std::vector<MeshData>* owned) {
+	const Clock::time_point start = Clock::now();
+	if (options_.storage == StorageMode::PerMesh) {
+		for (size_t i = 0; i < views.size(); i++) {
+			if (owned)
+				meshes_.push_back(Mesh(std::move((*owned)[i]), options_.vertexFormat, options_.cpuGeometry));
+			else
+				meshes_.push_back(Mesh(views[i], options_.vertexFormat, options_.cpuGeometry));
+			countMesh(meshes_.back(), views[i].numVertices, views[i].numIndices);
+		}
+		loadStats_.meshUploadMs += elapsedMs(start);
+		return;
+	}
+
+	// Pack every mesh into one vertex and one index buffer behind a single VAO
+	// Indices are relative to each mesh's base vertex, so the largest mesh decides the index size
+	size_t numVertices = 0, numIndices = 0, maxVertices = 0;
+	for (const MeshView& view : views) {
+		numVertices += view.numVertices;
+		numIndices += view.numIndices;
+		maxVertices = std::max<size_t>(maxVertices, view.numVertices);
+	}
+	const uint32_t indexBytes = indexSize(maxVertices);
+	glGenVertexArrays(1, &VAO_);
+	glGenBuffers(1, &VBO_);
+	glGenBuffers(1, &EBO_);
+
+	GLState::instance().bindVertexArray(VAO_);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+	const uint32_t stride = vertexStride(options_.vertexFormat);
+	glBufferData(GL_ARRAY_BUFFER, numVertices * stride, nullptr, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, numIndices * indexBytes, nullptr, GL_STATIC_DRAW);
+
+	MeshRange range = { VAO_, 0, 0, indexBytes };
+	std::vector<uint8_t> packed;
+	for (size_t i = 0; i < views.size(); i++) {
+		const MeshView& view = views[i];
+		if (options_.vertexFormat == VertexFormat::Full) {
+			glBufferSubData(GL_ARRAY_BUFFER, range.baseVertex * stride, view.numVertices * stride, view.vertices);
+		}
+		else {
+			packVertices(view.vertices, view.numVertices, options_.vertexFormat, &packed);
+			glBufferSubData(GL_ARRAY_BUFFER, range.baseVertex * stride, packed.size(), packed.data());
+		}
+		packIndices(view.indices, view.numIndices, indexBytes, &packed);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, range.firstIndex * indexBytes, packed.size(), packed.data());
+		if (owned)
+			meshes_.push_back(Mesh(std::move((*owned)[i]), range, options_.vertexFormat, options_.cpuGeometry));
+		else
+			meshes_.push_back(Mesh(view, range, options_.vertexFormat, options_.cpuGeometry));
+		countMesh(meshes_.back(), view.numVertices, view.numIndices);
+		range.baseVertex += view.numVertices;
+		range.firstIndex += view.numIndices;
+	}
+
+	setupVertexAttributes(options_.vertexFormat);
+	if (options_.indirect) { // the draw list has no per-draw transforms
+		if (isFlat(scene_, meshes_.size())) indirect_.reset(new IndirectDrawList(meshes_, VAO_, indexBytes));
+		else std::cout << "WARNING::MODEL:: Nodes transform or repeat meshes, indirect drawing disabled" << std::endl;
+	}
+	GLState::instance().bindVertexArray(0);
+	loadStats_.meshUploadMs += elapsedMs(start);
 }
 
 void Model::loadModel(std::string const path) {
+	const Clock::time_point start = Clock::now();
+	directory_ = path.substr(0, path.find_last_of('/'));
+
+	MeshCache cache(path, k_ImportFlags);
+	loadStats_.cacheHit = cache.load();
+	loadStats_.cacheReadMs = elapsedMs(start);
+	if (loadStats_.cacheHit) { // warm load, Assimp is never touched
+		loadFromCache(cache);
+		loadStats_.totalMs = elapsedMs(start);
+		return;
+	}
+
+	std::vector<MeshData> meshes;
+	if (!importMeshes(path, cache, &meshes, &scene_, &optimizationStats_, &loadStats_)) return;
+
+	std::vector<Texture*> textures;
+	for (MeshData& mesh : meshes)
+		for (Texture& texture : mesh.textures)
+			textures.push_back(&texture);
+	loadTextures(textures);
+
+	std::vector<MeshView> views;
+	for (const MeshData& mesh : meshes)
+		views.push_back(viewOf(mesh));
+	createMeshes(views, &meshes);
+	loadStats_.totalMs = elapsedMs(start);
+}
+
+bool Model::importMeshes(std::string const &path, const MeshCache& cache, std::vector<MeshData>* meshes,
+	SceneGraph* nodes, std::vector<MeshOptimizationStats>* stats, ModelLoadStats* loadStats) {
+	Clock::time_point start = Clock::now();
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(path.c_str(),
-		aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+	const aiScene* scene = importer.ReadFile(path.c_str(), k_ImportFlags);
+	loadStats->parseMs = elapsedMs(start);
 	if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
 		std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
-		return;
+		return false;
 	}
-	directory_ = path.substr(0, path.find_last_of('/'));
-	processNode(scene->mRootNode, scene);
+	start = Clock::now();
+	std::vector<int32_t> converted(scene->mNumMeshes, -1);
+	nodes->clear();
+	processNode(scene->mRootNode, scene, SceneGraph::k_NoParent, meshes, nodes, &converted, loadStats);
+	loadStats->traverseMs = elapsedMs(start) - loadStats->convertMs;
+
+	// Faces come in file order with one vertex per corner; weld and reorder before caching
+	stats->resize(meshes->size());
+	for (size_t i = 0; i < meshes->size(); i++) {
+		start = Clock::now();
+		optimizeMesh((*meshes)[i], &(*stats)[i]);
+		loadStats->optimizeMs += elapsedMs(start);
+		start = Clock::now();
+		generateLods((*meshes)[i]);
+		loadStats->lodMs += elapsedMs(start);
+	}
+
+	start = Clock::now();
+	if (!cache.write(*meshes, *nodes)) {
+		std::cout << "WARNING::MESHCACHE:: Could not write " << cache.cachePath() << std::endl;
+	}
+	loadStats->cacheWriteMs = elapsedMs(start);
+	return true;
+}
+
+void Model::loadFromCache(const MeshCache& cache) {
+	std::vector<MeshView> meshes;
+	std::vector<Texture*> textures;
+	for (uint32_t i = 0; i < cache.meshCount(); i++)
+		meshes.push_back(cache.mesh(i));
+	cache.scene(&scene_);
+	for (MeshView& mesh : meshes)
+		for (Texture& texture : mesh.textures)
+			textures.push_back(&texture);
+	loadTextures(textures);
+
+	createMeshes(meshes);
 }
 
-void Model::processNode(aiNode *node, const aiScene *scene) {
+void Model::processNode(aiNode *node, const aiScene *scene, const int32_t parent, std::vector<MeshData>* meshes,
+	SceneGraph* nodes, std::vector<int32_t>* converted, ModelLoadStats* loadStats) {
+	const uint32_t index = nodes->addNode(node->mName.C_Str(), parent, toMat4(node->mTransformation));
 	for (uint32_t i = 0; i < node->mNumMeshes; i++) {
-		aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-		meshes_.push_back(processMesh(mesh, scene));
+		int32_t& mesh = (*converted)[node->mMeshes[i]];
+		if (mesh < 0) { // first node drawing it
+			const Clock::time_point start = Clock::now();
+			mesh = static_cast<int32_t>(meshes->size());
+			meshes->push_back(processMesh(scene->mMeshes[node->mMeshes[i]], scene));
+			loadStats->convertMs += elapsedMs(start);
+		}
+		nodes->addDraw(index, static_cast<uint32_t>(mesh));
 	}
 	for (uint32_t i = 0; i < node->mNumChildren; i++) {
-		processNode(node->mChildren[i], scene);
+		processNode(node->mChildren[i], scene, static_cast<int32_t>(index), meshes, nodes, converted, loadStats);
 	}
 }
 
-Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene) {
+MeshData Model::processMesh(aiMesh *mesh, const aiScene *scene) {
 	std::vector<Vertex> vertices;
 	std::vector<uint32_t> indices;
 	std::vector<Texture> textures;
@@ -99,53 +728,12 @@ Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene) {
 	// 4. height maps
 	std::vector<Texture> heightMaps = loadMaterialTextures(material, aiTextureType_AMBIENT, "texture_height");
 	textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
-	return Mesh(vertices, indices, textures);
-}
-
-static unsigned int TextureFromFile(const char *path, const std::string &directory, bool gamma)
-{
-	std::string filename = std::string(path);
-	filename = directory + '/' + filename;
-
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-
-	int width, height, nrComponents;
-	unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-
-	if (data)
-	{
-		GLenum format;
-		if (nrComponents == 1)
-		{
-			format = GL_RED;
-		} 
-		else if (nrComponents == 3)
-		{
-			format = GL_RGB;
-		}
-		else if (nrComponents == 4)
-		{
-			format = GL_RGBA;
-		}
-
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		stbi_image_free(data);
-	} else
-	{
-		std::cout << "Texture failed to load at path: " << path << std::endl;
-		stbi_image_free(data);
-	}
-
-	return textureID;
+	MeshData data;
+	data.vertices.swap(vertices);
+	data.indices.swap(indices);
+	data.textures.swap(textures);
+	return data;
 }
 
 std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat,
@@ -154,22 +742,65 @@ std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat,
 	for (uint32_t i = 0; i < mat->GetTextureCount(type); i++) {
 		aiString str;
 		mat->GetTexture(type, i, &str);
-		bool skip = false; // check if texture was loaded before
-		for (uint32_t j = 0; j < textures_loaded_.size(); j++) {
-			if (std::strcmp(textures_loaded_[j].path.data(), str.C_Str()) == 0) {
-				textures.push_back(textures_loaded_[j]);
-				skip = true;
-				break;
-			}
-		}
-		if (!skip) { // if texture hasn't been loaded already, load it
-			Texture texture;
-			texture.id = TextureFromFile(str.C_Str(), directory_, false);
-			texture.type = typeName;
-			texture.path = str.C_Str();
-			textures.push_back(texture);
-			textures_loaded_.push_back(texture);
-		}
+		Texture texture; // only recorded here, loaded in loadTextures
+		texture.id = 0;
+		texture.type = typeName;
+		texture.path = str.C_Str();
+		textures.push_back(texture);
 	}
 	return textures;
-}
\ No newline at end of file
+}
+
+void Model::loadTextures(const std::vector<Texture*>& textures) {
+	TextureCache& cache = TextureCache::instance();
+	const bool hashContent = cache.contentHashing();
+
+	// Resolve each distinct texture once: resident ones come from the global cache,
+	// the rest are queued for decoding
+	std::vector<std::string> keys;
+	std::unordered_map<std::string, TextureHandle> resolved;
+	std::unordered_map<std::string, size_t> loadedIndex;
+	std::vector<std::string> pending;
+	for (const Texture* texture : textures) {
+		keys.push_back(TextureCache::normalizePath(directory_ + '/' + texture->path));
+		if (resolved.count(keys.back())) continue;
+
+		TextureHandle handle = cache.find(keys.back());
+		if (!handle) pending.push_back(keys.back());
+		else loadStats_.texturesShared++;
+		resolved[keys.back()] = handle;
+
+		loadedIndex[keys.back()] = textures_loaded_.size();
+		textures_loaded_.push_back(*texture);
+	}
+
+	// Decode every image on the worker pool, then upload each one on this (GL) thread
+	// as soon as it is ready, while the rest are still decoding
+	std::vector<std::future<DecodedImage>> decoded;
+	for (const std::string& key : pending) {
+		decoded.push_back(ThreadPool::shared().submit([key, hashContent]() { return decodeImage(key, hashContent); }));
+	}
+	for (uint32_t i = 0; i < pending.size(); i++) {
+		DecodedImage image = decoded[i].get();
+
+		TextureTiming timing;
+		timing.path = pending[i];
+		timing.decodeMs = image.decodeMs;
+		resolved[pending[i]] = cache.insert(pending[i], image, &timing.uploadMs, &timing.mipmapMs);
+		textureTimings_.push_back(timing);
+		loadStats_.textureDecodeMs += timing.decodeMs;
+		loadStats_.textureUploadMs += timing.uploadMs;
+		loadStats_.mipmapMs += timing.mipmapMs;
+		loadStats_.texturesDecoded++;
+	}
+
+	for (uint32_t i = 0; i < textures.size(); i++) {
+		textures[i]->handle = resolved[keys[i]];
+		textures[i]->id = textures[i]->handle->id();
+	}
+	for (const auto& entry : loadedIndex) {
+		Texture& loaded = textures_loaded_[entry.second];
+		loaded.handle = resolved[entry.first];
+		loaded.id = loaded.handle->id();
+	}
+}
@@ -0,0 +1,321 @@
+#include "occlusion_culler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iostream>
+
+#include "frustum_cull.h"
+#include "mesh.h"
+#include "model.h"
+#include "thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_CULLER_SSE 1
+#endif
+
+namespace {
+	typedef std::chrono::high_resolution_clock Clock;
+
+	const uint32_t k_MinParallelTests = 1024; // fewer boxes are tested on the calling thread
+	const uint32_t k_MaxTestTexels = 3; // per axis, at the pyramid level chosen for a box
+
+	double elapsedMs(const Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	// Signed distance to the near plane z = -w, in clip space
+	float nearDistance(const glm::vec4& v) {
+		return v.z + v.w;
+	}
+}
+
+OcclusionCuller::OcclusionCuller(const uint32_t width, const uint32_t height, const uint32_t threads) :
+	width_((std::max(width, 4u) + 3) & ~3u),
+	height_(std::max(height, 1u)),
+	pool_(new ThreadPool(threads))
+{
+	size_t offset = 0;
+	uint32_t levelWidth = width_, levelHeight = height_;
+	while (true) {
+		const Level level = { levelWidth, levelHeight, offset };
+		levels_.push_back(level);
+		offset += size_t(levelWidth) * levelHeight;
+		if (levelWidth == 1 && levelHeight == 1) break;
+		levelWidth = std::max(1u, (levelWidth + 1) / 2);
+		levelHeight = std::max(1u, (levelHeight + 1) / 2);
+	}
+	pyramid_.assign(offset, 1.0f);
+}
+
+OcclusionCuller::~OcclusionCuller() = default;
+
+void OcclusionCuller::begin(const glm::mat4& viewProj) {
+	viewProj_ = viewProj;
+	triangles_.clear();
+	std::fill(pyramid_.begin(), pyramid_.end(), 1.0f);
+	stats_ = OcclusionStats();
+}
+
+void OcclusionCuller::addOccluder(const glm::vec3* positions, const uint32_t numVertices, const uint32_t* indices,
+	const uint32_t numIndices, const glm::mat4& model) {
+	const Clock::time_point start = Clock::now();
+	const glm::mat4 transform = viewProj_ * model;
+	clip_.resize(numVertices);
+	for (uint32_t i = 0; i < numVertices; i++)
+		clip_[i] = transform * glm::vec4(positions[i], 1.0f);
+
+	for (uint32_t i = 0; i + 2 < numIndices; i += 3) {
+		const glm::vec4* corners[3] = { &clip_[indices[i]], &clip_[indices[i + 1]], &clip_[indices[i + 2]] };
+		const uint32_t inFront = (nearDistance(*corners[0]) >= 0.0f) + (nearDistance(*corners[1]) >= 0.0f) + (nearDistance(*corners[2]) >= 0.0f);
+		if (inFront == 3) {
+			setupTriangle(*corners[0], *corners[1], *corners[2]);
+			continue;
+		}
+		if (inFront == 0) continue;
+
+		// Cut off the part behind the near plane, leaving one or two triangles
+		glm::vec4 polygon[4];
+		uint32_t count = 0;
+		for (uint32_t k = 0; k < 3; k++) {
+			const glm::vec4& from = *corners[k];
+			const glm::vec4& to = *corners[(k + 1) % 3];
+			const float fromDistance = nearDistance(from), toDistance = nearDistance(to);
+			if (fromDistance >= 0.0f) polygon[count++] = from;
+			if ((fromDistance >= 0.0f) != (toDistance >= 0.0f))
+				polygon[count++] = from + (to - from) * (fromDistance / (fromDistance - toDistance));
+		}
+		for (uint32_t k = 2; k < count; k++)
+			setupTriangle(polygon[0], polygon[k - 1], polygon[k]);
+	}
+	stats_.occluders++;
+	stats_.triangles += numIndices / 3;
+	stats_.setupMs += elapsedMs(start);
+}
+
+void OcclusionCuller::addOccluder(const Mesh& mesh, const glm::mat4& model) {
+	if (!mesh.positions_.empty()) { // Collision keeps the full resolution indices only
+		addOccluder(mesh.positions_.data(), static_cast<uint32_t>(mesh.positions_.size()),
+			mesh.indices_.data(), static_cast<uint32_t>(mesh.indices_.size()), model);
+		return;
+	}
+	if (mesh.vertices_.empty() || mesh.indices_.empty()) {
+		std::cout << "ERROR::OCCLUSION:: Occluder mesh has no CPU geometry, keep it with CpuGeometry::Keep or Collision" << std::endl;
+		return;
+	}
+	std::vector<glm::vec3> positions(mesh.vertices_.size());
+	for (size_t i = 0; i < positions.size(); i++)
+		positions[i] = mesh.vertices_[i].Position;
+	const MeshLod& level = mesh.lods_[0];
+	addOccluder(positions.data(), static_cast<uint32_t>(positions.size()),
+		mesh.indices_.data() + level.firstIndex, level.numIndices, model);
+}
+
+void OcclusionCuller::addOccluder(const Model& object, const glm::mat4& model) {
+	for (const SceneDraw& draw : object.scene_.draws()) {
+		if (draw.mesh < object.meshes_.size())
+			addOccluder(object.meshes_[draw.mesh], model * object.scene_.world(draw.node));
+	}
+}
+
+void OcclusionCuller::setupTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+	// Clip space to pixels, depth to [0, 1]
+	const glm::vec4* clip[3] = { &a, &b, &c };
+	float x[3], y[3], z[3];
+	for (uint32_t i = 0; i < 3; i++) {
+		const float invW = 1.0f / clip[i]->w;
+		x[i] = (clip[i]->x * invW * 0.5f + 0.5f) * width_;
+		y[i] = (clip[i]->y * invW * 0.5f + 0.5f) * height_;
+		z[i] = clip[i]->z * invW * 0.5f + 0.5f;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (std::abs(area) < 1e-8f) return;
+	if (area < 0.0f) { // both faces occlude, make it counter-clockwise
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		std::swap(z[1], z[2]);
+		area = -area;
+	}
+
+	// Pixels whose center (i + 0.5) lies within the bounds
+	const float minX = std::min(x[0], std::min(x[1], x[2])), maxX = std::max(x[0], std::max(x[1], x[2]));
+	const float minY = std::min(y[0], std::min(y[1], y[2])), maxY = std::max(y[0], std::max(y[1], y[2]));
+	Triangle triangle;
+	triangle.minX = static_cast<int32_t>(glm::clamp(std::ceil(minX - 0.5f), 0.0f, static_cast<float>(width_)));
+	triangle.maxX = static_cast<int32_t>(glm::clamp(std::floor(maxX - 0.5f), -1.0f, width_ - 1.0f));
+	triangle.minY = static_cast<int32_t>(glm::clamp(std::ceil(minY - 0.5f), 0.0f, static_cast<float>(height_)));
+	triangle.maxY = static_cast<int32_t>(glm::clamp(std::floor(maxY - 0.5f), -1.0f, height_ - 1.0f));
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) return;
+
+	for (uint32_t i = 0; i < 3; i++) {
+		const uint32_t j = (i + 1) % 3;
+		triangle.edgeA[i] = y[i] - y[j];
+		triangle.edgeB[i] = x[j] - x[i];
+		triangle.edgeC[i] = -(triangle.edgeA[i] * x[i] + triangle.edgeB[i] * y[i]);
+	}
+	triangle.depthA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+	triangle.depthB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+	triangle.depthC = z[0] - triangle.depthA * x[0] - triangle.depthB * y[0];
+	triangles_.push_back(triangle);
+}
+
+void OcclusionCuller::rasterize() {
+	Clock::time_point start = Clock::now();
+	stats_.trianglesRasterized = static_cast<uint32_t>(triangles_.size());
+
+	// One band of rows per worker, each band only writes its own rows
+	const int32_t bands = static_cast<int32_t>(std::min(pool_->size(), height_));
+	if (bands <= 1) {
+		rasterizeBand(0, height_);
+	}
+	else {
+		std::vector<std::future<void>> done;
+		for (int32_t band = 0; band < bands; band++) {
+			const int32_t firstRow = band * static_cast<int32_t>(height_) / bands;
+			const int32_t endRow = (band + 1) * static_cast<int32_t>(height_) / bands;
+			done.push_back(pool_->submit([this, firstRow, endRow]() { rasterizeBand(firstRow, endRow); }));
+		}
+		for (std::future<void>& band : done) band.get();
+	}
+	stats_.rasterMs = elapsedMs(start);
+
+	start = Clock::now();
+	buildPyramid();
+	stats_.hizMs = elapsedMs(start);
+}
+
+void OcclusionCuller::rasterizeBand(const int32_t firstRow, const int32_t endRow) {
+	float* depth = pyramid_.data();
+	for (const Triangle& triangle : triangles_) {
+		const int32_t minY = std::max(triangle.minY, firstRow);
+		const int32_t maxY = std::min(triangle.maxY, endRow - 1);
+		for (int32_t y = minY; y <= maxY; y++) {
+			const float centerY = y + 0.5f;
+			float* row = depth + size_t(y) * width_;
+			// Edge functions and depth at x = 0 of this row
+			const float rowEdge0 = triangle.edgeB[0] * centerY + triangle.edgeC[0];
+			const float rowEdge1 = triangle.edgeB[1] * centerY + triangle.edgeC[1];
+			const float rowEdge2 = triangle.edgeB[2] * centerY + triangle.edgeC[2];
+			const float rowDepth = triangle.depthB * centerY + triangle.depthC;
+
+#ifdef OCCLUSION_CULLER_SSE
+			if (simd_) {
+				// Groups of 4 aligned pixels, width_ is a multiple of 4
+				const __m128 edgeA0 = _mm_set1_ps(triangle.edgeA[0]), edgeA1 = _mm_set1_ps(triangle.edgeA[1]), edgeA2 = _mm_set1_ps(triangle.edgeA[2]);
+				const __m128 edgeRow0 = _mm_set1_ps(rowEdge0), edgeRow1 = _mm_set1_ps(rowEdge1), edgeRow2 = _mm_set1_ps(rowEdge2);
+				const __m128 depthA = _mm_set1_ps(triangle.depthA), depthRow = _mm_set1_ps(rowDepth);
+				const __m128 zero = _mm_setzero_ps();
+				__m128 centerX = _mm_add_ps(_mm_set1_ps((triangle.minX & ~3) + 0.5f), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+				const __m128 step = _mm_set1_ps(4.0f);
+				for (int32_t x = triangle.minX & ~3; x <= triangle.maxX; x += 4, centerX = _mm_add_ps(centerX, step)) {
+					const __m128 edge0 = _mm_add_ps(_mm_mul_ps(edgeA0, centerX), edgeRow0);
+					const __m128 edge1 = _mm_add_ps(_mm_mul_ps(edgeA1, centerX), edgeRow1);
+					const __m128 edge2 = _mm_add_ps(_mm_mul_ps(edgeA2, centerX), edgeRow2);
+					const __m128 inside = _mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_and_ps(_mm_cmpge_ps(edge1, zero), _mm_cmpge_ps(edge2, zero)));
+					if (_mm_movemask_ps(inside) == 0) continue;
+					const __m128 current = _mm_loadu_ps(row + x);
+					const __m128 nearest = _mm_min_ps(current, _mm_add_ps(_mm_mul_ps(depthA, centerX), depthRow));
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+				}
+				continue;
+			}
+#endif
+			for (int32_t x = triangle.minX; x <= triangle.maxX; x++) {
+				const float centerX = x + 0.5f;
+				if (triangle.edgeA[0] * centerX + rowEdge0 < 0.0f ||
+					triangle.edgeA[1] * centerX + rowEdge1 < 0.0f ||
+					triangle.edgeA[2] * centerX + rowEdge2 < 0.0f) continue;
+				row[x] = std::min(row[x], triangle.depthA * centerX + rowDepth);
+			}
+		}
+	}
+}
+
+void OcclusionCuller::buildPyramid() {
+	// Each texel keeps the farthest depth of the 2x2 texels below it
+	for (uint32_t l = 1; l < levels_.size(); l++) {
+		const Level& below = levels_[l - 1];
+		const Level& level = levels_[l];
+		const float* source = &pyramid_[below.offset];
+		float* target = &pyramid_[level.offset];
+		for (uint32_t y = 0; y < level.height; y++) {
+			const uint32_t y0 = std::min(2 * y, below.height - 1), y1 = std::min(2 * y + 1, below.height - 1);
+			for (uint32_t x = 0; x < level.width; x++) {
+				const uint32_t x0 = std::min(2 * x, below.width - 1), x1 = std::min(2 * x + 1, below.width - 1);
+				target[y * level.width + x] = std::max(std::max(source[y0 * below.width + x0], source[y0 * below.width + x1]),
+					std::max(source[y1 * below.width + x0], source[y1 * below.width + x1]));
+			}
+		}
+	}
+}
+
+bool OcclusionCuller::isVisible(const glm::vec3& center, const glm::vec3& extents) const {
+	// Screen rectangle and nearest depth of the eight corners
+	float minX = 1e30f, maxX = -1e30f, minY = 1e30f, maxY = -1e30f, nearest = 1e30f;
+	for (uint32_t i = 0; i < 8; i++) {
+		const glm::vec3 corner = center + extents * glm::vec3(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f);
+		const glm::vec4 clip = viewProj_ * glm::vec4(corner, 1.0f);
+		if (nearDistance(clip) < 0.0f) return true; // crosses the near plane, assume visible
+		const float invW = 1.0f / clip.w;
+		const float x = (clip.x * invW * 0.5f + 0.5f) * width_;
+		const float y = (clip.y * invW * 0.5f + 0.5f) * height_;
+		minX = std::min(minX, x); maxX = std::max(maxX, x);
+		minY = std::min(minY, y); maxY = std::max(maxY, y);
+		nearest = std::min(nearest, clip.z * invW * 0.5f + 0.5f);
+	}
+	if (maxX < 0.0f || minX > width_ || maxY < 0.0f || minY > height_) return false;
+
+	// Every pixel the rectangle touches
+	const uint32_t pixelX0 = static_cast<uint32_t>(std::max(minX, 0.0f)), pixelX1 = static_cast<uint32_t>(std::min(maxX, width_ - 1.0f));
+	const uint32_t pixelY0 = static_cast<uint32_t>(std::max(minY, 0.0f)), pixelY1 = static_cast<uint32_t>(std::min(maxY, height_ - 1.0f));
+	uint32_t l = 0;
+	while (l + 1 < levels_.size() &&
+		((pixelX1 >> l) - (pixelX0 >> l) >= k_MaxTestTexels || (pixelY1 >> l) - (pixelY0 >> l) >= k_MaxTestTexels))
+		l++;
+
+	const Level& level = levels_[l];
+	const float* texels = &pyramid_[level.offset];
+	float farthest = 0.0f;
+	for (uint32_t y = pixelY0 >> l; y <= std::min(pixelY1 >> l, level.height - 1); y++) {
+		for (uint32_t x = pixelX0 >> l; x <= std::min(pixelX1 >> l, level.width - 1); x++)
+			farthest = std::max(farthest, texels[y * level.width + x]);
+	}
+	return nearest <= farthest;
+}
+
+void OcclusionCuller::cull(const CullBounds& bounds, const std::vector<uint32_t>& candidates, std::vector<uint32_t>* visible) {
+	const Clock::time_point start = Clock::now();
+	const size_t count = candidates.size();
+	const size_t first = visible->size();
+	const uint32_t chunks = count < k_MinParallelTests ? 1 : pool_->size();
+	if (chunks <= 1) {
+		for (const uint32_t i : candidates) {
+			if (isVisible(bounds.center(i), bounds.extents(i))) visible->push_back(i);
+		}
+	}
+	else {
+		// Contiguous chunks, joined in order
+		std::vector<std::future<std::vector<uint32_t>>> results;
+		for (uint32_t chunk = 0; chunk < chunks; chunk++) {
+			const size_t begin = chunk * count / chunks, end = (chunk + 1) * count / chunks;
+			results.push_back(pool_->submit([this, &bounds, &candidates, begin, end]() {
+				std::vector<uint32_t> kept;
+				for (size_t k = begin; k < end; k++) {
+					const uint32_t i = candidates[k];
+					if (isVisible(bounds.center(i), bounds.extents(i))) kept.push_back(i);
+				}
+				return kept;
+			}));
+		}
+		for (std::future<std::vector<uint32_t>>& result : results) {
+			const std::vector<uint32_t> kept = result.get();
+			visible->insert(visible->end(), kept.begin(), kept.end());
+		}
+	}
+	stats_.tested += static_cast<uint32_t>(count);
+	stats_.culled += static_cast<uint32_t>(count - (visible->size() - first));
+	stats_.testMs += elapsedMs(start);
+}
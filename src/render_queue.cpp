@@ -0,0 +1,209 @@
+#include "render_queue.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "gl_state.h"
+#include "mesh.h"
+#include "shader.h"
+
+namespace {
+	typedef std::chrono::high_resolution_clock Clock;
+
+	const uint32_t k_ProgramBits = 12;
+	const uint32_t k_MaterialBits = 16;
+	const uint32_t k_VAOBits = 10;
+	const uint32_t k_DepthBits = 24;
+
+	const uint32_t k_RadixBits = 8;
+	const uint32_t k_RadixPasses = 64 / k_RadixBits;
+	const uint32_t k_Buckets = 1 << k_RadixBits;
+
+	uint64_t field(const uint32_t value, const uint32_t bits) {
+		return value & ((uint64_t(1) << bits) - 1);
+	}
+
+	// FNV-1a over the texture names, folded to the key field
+	uint32_t materialOf(const uint32_t* textures, const uint32_t count) {
+		uint32_t hash = 2166136261u;
+		for (uint32_t i = 0; i < count; i++) {
+			hash ^= textures[i];
+			hash *= 16777619u;
+		}
+		return hash ^ (hash >> k_MaterialBits);
+	}
+
+	double elapsedMs(const Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+}
+
+uint64_t RenderQueue::makeKey(const RenderPass pass, const uint32_t program, const uint32_t material,
+	const uint32_t VAO, const float depth) {
+	const uint32_t maxDepth = (1u << k_DepthBits) - 1;
+	const uint32_t quantized = static_cast<uint32_t>(std::min(std::max(depth, 0.0f), 1.0f) * maxDepth);
+
+	uint64_t key = uint64_t(pass) << 62;
+	if (pass == RenderPass::Opaque) {
+		key |= field(program, k_ProgramBits) << (k_MaterialBits + k_VAOBits + k_DepthBits);
+		key |= field(material, k_MaterialBits) << (k_VAOBits + k_DepthBits);
+		key |= field(VAO, k_VAOBits) << k_DepthBits;
+		key |= quantized;
+	} else {
+		key |= uint64_t(maxDepth - quantized) << (k_ProgramBits + k_MaterialBits + k_VAOBits);
+		key |= field(program, k_ProgramBits) << (k_MaterialBits + k_VAOBits);
+		key |= field(material, k_MaterialBits) << k_VAOBits;
+		key |= field(VAO, k_VAOBits);
+	}
+	return key;
+}
+
+void RenderQueue::begin(const glm::mat4& view, const float zNear, const float zFar) {
+	view_ = view;
+	zNear_ = zNear;
+	zFar_ = zFar;
+	packets_.clear();
+	entries_.clear();
+	sorted_ = false;
+	stats_ = RenderQueueStats();
+}
+
+float RenderQueue::depthOf(const glm::vec3& center) const {
+	const float distance = -(view_ * glm::vec4(center, 1.0f)).z;
+	return (distance - zNear_) / (zFar_ - zNear_);
+}
+
+void RenderQueue::push(const DrawPacket& packet, const RenderPass pass, const uint32_t material, const glm::vec3& center) {
+	const SortEntry entry = {
+		makeKey(pass, packet.shader->id(), material, packet.VAO, depthOf(center)),
+		static_cast<uint32_t>(packets_.size())
+	};
+	packets_.push_back(packet);
+	entries_.push_back(entry);
+	sorted_ = false;
+}
+
+void RenderQueue::enqueue(const Shader& shader, const Mesh& mesh, const glm::mat4& model,
+	const RenderPass pass, const uint32_t lod) {
+	DrawPacket packet;
+	packet.shader = &shader;
+	packet.mesh = &mesh;
+	packet.lod = std::min(lod, static_cast<uint32_t>(mesh.lods_.size()) - 1);
+	packet.VAO = mesh.VAO_;
+	packet.count = 0;
+	packet.numTextures = static_cast<uint32_t>(std::min(mesh.textures_.size(), size_t(DrawPacket::k_MaxTextures)));
+	for (uint32_t i = 0; i < packet.numTextures; i++)
+		packet.textures[i] = mesh.textures_[i].id;
+	packet.model = model;
+	push(packet, pass, materialOf(packet.textures, packet.numTextures), glm::vec3(model * glm::vec4(mesh.boundsCenter_, 1.0f)));
+}
+
+void RenderQueue::enqueue(const Shader& shader, const uint32_t VAO, const uint32_t count, const glm::mat4& model,
+	const RenderPass pass, const uint32_t* textures, const uint32_t numTextures) {
+	DrawPacket packet;
+	packet.shader = &shader;
+	packet.mesh = nullptr;
+	packet.lod = 0;
+	packet.VAO = VAO;
+	packet.count = count;
+	packet.numTextures = std::min(numTextures, DrawPacket::k_MaxTextures);
+	for (uint32_t i = 0; i < packet.numTextures; i++)
+		packet.textures[i] = textures[i];
+	packet.model = model;
+	push(packet, pass, materialOf(packet.textures, packet.numTextures), glm::vec3(model[3]));
+}
+
+void RenderQueue::sort() {
+	const Clock::time_point start = Clock::now();
+	const size_t count = entries_.size();
+	scratch_.resize(count);
+
+	// LSD radix sort, the histograms of every digit come from a single scan
+	uint32_t histograms[k_RadixPasses][k_Buckets];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (const SortEntry& entry : entries_) {
+		for (uint32_t pass = 0; pass < k_RadixPasses; pass++)
+			histograms[pass][(entry.key >> (pass * k_RadixBits)) & (k_Buckets - 1)]++;
+	}
+
+	SortEntry* src = entries_.data();
+	SortEntry* dst = scratch_.data();
+	for (uint32_t pass = 0; pass < k_RadixPasses; pass++) {
+		uint32_t* histogram = histograms[pass];
+		const uint32_t shift = pass * k_RadixBits;
+		// Every key has the same digit, the order is already right for it
+		if (count == 0 || histogram[(src[0].key >> shift) & (k_Buckets - 1)] == count) continue;
+
+		uint32_t offset = 0;
+		for (uint32_t bucket = 0; bucket < k_Buckets; bucket++) {
+			const uint32_t size = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += size;
+		}
+		for (size_t i = 0; i < count; i++)
+			dst[histogram[(src[i].key >> shift) & (k_Buckets - 1)]++] = src[i];
+		std::swap(src, dst);
+	}
+	if (src != entries_.data()) entries_.swap(scratch_);
+
+	sorted_ = true;
+	stats_.sortMs += elapsedMs(start);
+}
+
+void RenderQueue::submit() {
+	if (sorting_ && !sorted_) sort();
+
+	static const UniformName k_Model("model");
+	static const UniformName k_NormalMat("normalMat");
+
+	const Clock::time_point start = Clock::now();
+	GLState& state = GLState::instance();
+	const DrawPacket* last = nullptr;
+	uint32_t lastPass = 0xFFFFFFFFu;
+	uint32_t lastMaterial = 0;
+	for (const SortEntry& entry : entries_) {
+		const DrawPacket& packet = packets_[entry.packet];
+		const uint32_t pass = static_cast<uint32_t>(entry.key >> 62);
+		if (pass != lastPass) {
+			const bool blended = pass == static_cast<uint32_t>(RenderPass::Blended);
+			state.setBlend(blended);
+			if (blended) state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			state.depthMask(!blended);
+			lastPass = pass;
+		}
+
+		const uint32_t material = materialOf(packet.textures, packet.numTextures);
+		if (!last || packet.shader != last->shader) {
+			packet.shader->use();
+			stats_.programChanges++;
+		}
+		if (!last || material != lastMaterial) stats_.materialChanges++;
+		if (!last || packet.VAO != last->VAO) stats_.VAOChanges++;
+		last = &packet;
+		lastMaterial = material;
+
+		packet.shader->set(k_Model, packet.model);
+		const UniformHandle normalMat = packet.shader->uniform(k_NormalMat);
+		if (normalMat.slot >= 0)
+			packet.shader->set(normalMat, glm::inverse(glm::transpose(glm::mat3(packet.model))));
+
+		state.bindVertexArray(packet.VAO);
+		if (packet.mesh) {
+			packet.mesh->bind(*packet.shader);
+			packet.mesh->drawElements(packet.lod);
+		} else {
+			for (uint32_t i = 0; i < packet.numTextures; i++)
+				state.bindTexture(i, GL_TEXTURE_2D, packet.textures[i]);
+			glDrawElements(GL_TRIANGLES, packet.count, GL_UNSIGNED_INT, nullptr);
+		}
+	}
+	state.setBlend(false);
+	state.depthMask(true);
+	state.activeTexture(0);
+
+	stats_.packets = static_cast<uint32_t>(entries_.size());
+	stats_.submitMs += elapsedMs(start);
+}
@@ -0,0 +1,69 @@
+#include "scene_graph.h"
+
+#include <algorithm>
+
+void SceneGraph::clear() {
+	parents_.clear();
+	subtreeEnds_.clear();
+	locals_.clear();
+	worlds_.clear();
+	dirty_.clear();
+	names_.clear();
+	draws_.clear();
+	firstDirty_ = 0;
+}
+
+uint32_t SceneGraph::addNode(const std::string& name, const int32_t parent, const glm::mat4& local) {
+	const uint32_t node = size();
+	parents_.push_back(parent);
+	subtreeEnds_.push_back(node + 1);
+	locals_.push_back(local);
+	worlds_.push_back(parent == k_NoParent ? local : worlds_[parent] * local);
+	dirty_.push_back(0);
+	names_.push_back(name);
+	for (int32_t ancestor = parent; ancestor != k_NoParent; ancestor = parents_[ancestor])
+		subtreeEnds_[ancestor] = node + 1;
+	if (firstDirty_ == node) firstDirty_ = node + 1; // added up to date
+	return node;
+}
+
+void SceneGraph::addDraw(const uint32_t node, const uint32_t mesh) {
+	const SceneDraw draw = { node, mesh };
+	draws_.push_back(draw);
+}
+
+int32_t SceneGraph::find(const std::string& name) const {
+	for (uint32_t i = 0; i < names_.size(); i++) {
+		if (names_[i] == name) return static_cast<int32_t>(i);
+	}
+	return k_NoParent;
+}
+
+void SceneGraph::setLocal(const uint32_t node, const glm::mat4& local) {
+	locals_[node] = local;
+	dirty_[node] = 1;
+	firstDirty_ = std::min(firstDirty_, node);
+}
+
+uint32_t SceneGraph::update() {
+	uint32_t updated = 0;
+	const uint32_t count = size();
+	uint32_t node = firstDirty_;
+	while (node < count) {
+		if (!dirty_[node]) {
+			node++;
+			continue;
+		}
+		// The whole subtree in order, parents are always done before their children
+		const uint32_t end = subtreeEnds_[node];
+		for (uint32_t i = node; i < end; i++) {
+			const int32_t parent = parents_[i];
+			worlds_[i] = parent == k_NoParent ? locals_[i] : worlds_[parent] * locals_[i];
+			dirty_[i] = 0;
+		}
+		updated += end - node;
+		node = end;
+	}
+	firstDirty_ = count;
+	return updated;
+}
@@ -1,67 +1,403 @@
 #include <shader.h>
+#include "frame_uniforms.h"
+#include "gl_extensions.h"
+#include "gl_state.h"
+#include "light_uniforms.h"
+#include "stream_buffer.h"
+#include "texture_cache.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath) {
-	std::string sVertexCode, sFragmentCode, sGeometryCode;
-	loadShader(vertexPath, &sVertexCode);
-	loadShader(fragmentPath, &sFragmentCode);
-	if (geometryPath) {
-		loadShader(geometryPath, &sGeometryCode);
-	}
-	const char* vertexCode = sVertexCode.c_str();
-	const char* fragmentCode = sFragmentCode.c_str();
-
-	uint32_t vertex = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertex, 1, &vertexCode, NULL);
-	glCompileShader(vertex);
-	
-	checkErrors(vertex, Type::Vertex);
-	
-	uint32_t fragment = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragment, 1, &fragmentCode, NULL);
-	glCompileShader(fragment);
-	
-	checkErrors(fragment, Type::Fragment);
-	
-	uint32_t geometry;
-	if (geometryPath) {
-		const char* geometryCode = sGeometryCode.c_str();
-		geometry = glCreateShader(GL_GEOMETRY_SHADER);
-		glShaderSource(geometry, 1, &geometryCode, NULL);
-		glCompileShader(geometry);
-		
-		checkErrors(geometry, Type::Geometry);
-	}
-	
+namespace {
+	typedef std::chrono::high_resolution_clock Clock;
+
+	const char k_BinaryMagic[4] = { 'M', 'V', 'P', 'B' };
+	const uint32_t k_BinaryVersion = 1;
+	const uint64_t k_FNVOffset = 14695981039346656037ULL;
+	const uint64_t k_FNVPrime = 1099511628211ULL;
+
+	struct BinaryHeader {
+		char magic[4];
+		uint32_t version;
+		uint64_t key;
+		uint32_t format;
+		uint32_t length;
+	};
+
+	// Compiled stage objects by stage type and final source, shared by every program using them
+	std::unordered_map<uint64_t, uint32_t> g_Stages;
+	bool g_StageSharing = true;
+
+	std::string g_ProgramCacheDir = "shader_cache";
+	bool g_ProgramCacheDirReady = false;
+	ProgramCacheStats g_ProgramCacheStats;
+
+	double elapsedMs(const Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	uint64_t hashBytes(const void* data, const size_t size, uint64_t hash) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= k_FNVPrime;
+		}
+		return hash;
+	}
+
+	uint64_t hashString(const char* text, const uint64_t hash) {
+		const uint64_t length = text ? std::strlen(text) : 0;
+		return hashBytes(text, length, hashBytes(&length, sizeof(length), hash));
+	}
+
+	// The binary is only valid for the exact sources on the exact driver that produced it
+	uint64_t programKey(const std::string* sources, const uint32_t numSources) {
+		uint64_t hash = hashBytes(&k_BinaryVersion, sizeof(k_BinaryVersion), k_FNVOffset);
+		hash = hashString(reinterpret_cast<const char*>(glGetString(GL_VENDOR)), hash);
+		hash = hashString(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), hash);
+		hash = hashString(reinterpret_cast<const char*>(glGetString(GL_VERSION)), hash);
+		for (uint32_t i = 0; i < numSources; i++) {
+			hash = hashString(sources[i].c_str(), hash);
+		}
+		return hash;
+	}
+
+	bool makeDirectory(const std::string& path) {
+#ifdef _WIN32
+		return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+		return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+	}
+
+	// Independent of the order the defines are given in
+	uint64_t hashDefines(const ShaderDefines& defines, uint64_t hash) {
+		std::vector<const ShaderDefine*> sorted;
+		for (const ShaderDefine& define : defines) sorted.push_back(&define);
+		std::sort(sorted.begin(), sorted.end(), [](const ShaderDefine* a, const ShaderDefine* b) {
+			return a->name < b->name;
+		});
+		for (const ShaderDefine* define : sorted) {
+			hash = hashString(define->name.c_str(), hash);
+			hash = hashString(define->value.c_str(), hash);
+		}
+		return hash;
+	}
+
+	ShaderDesc describe(const char* vertexPath, const char* fragmentPath, const char* geometryPath) {
+		ShaderDesc desc;
+		desc.vertexPath = vertexPath;
+		desc.fragmentPath = fragmentPath;
+		if (geometryPath) desc.geometryPath = geometryPath;
+		return desc;
+	}
+
+	// The defines go right after the #version line, which has to stay first. The #line
+	// directive keeps compiler messages pointing at the lines of the file.
+	std::string injectDefines(const std::string& source, const ShaderDefines& defines) {
+		if (defines.empty()) return source;
+
+		size_t insert = 0;
+		const size_t version = source.find("#version");
+		if (version != std::string::npos) {
+			const size_t end = source.find('\n', version);
+			insert = (end == std::string::npos) ? source.size() : end + 1;
+		}
+		std::string block = (insert > 0 && source[insert - 1] != '\n') ? "\n" : "";
+		const size_t nextLine = 1 + block.size() + std::count(source.begin(), source.begin() + insert, '\n');
+		for (const ShaderDefine& define : defines) {
+			block += "#define " + define.name + (define.value.empty() ? "" : " " + define.value) + "\n";
+		}
+		block += "#line " + std::to_string(nextLine) + "\n";
+		return source.substr(0, insert) + block + source.substr(insert);
+	}
+
+	std::string binaryPath(const uint64_t key) {
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.progbin", static_cast<unsigned long long>(key));
+		return g_ProgramCacheDir + "/" + name;
+	}
+}
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath) :
+	Shader(vertexPath, fragmentPath, geometryPath, ShaderCompile::Blocking) {}
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath, const ShaderCompile mode) :
+	Shader(describe(vertexPath, fragmentPath, geometryPath), mode) {}
+
+Shader::Shader(const ShaderDesc& desc, const ShaderCompile mode) :
+	pending_(new Pending())
+{
+	Pending& pending = *pending_;
+	loadShader(desc.vertexPath.c_str(), &pending.sources[0]);
+	loadShader(desc.fragmentPath.c_str(), &pending.sources[1]);
+	if (!desc.geometryPath.empty()) {
+		loadShader(desc.geometryPath.c_str(), &pending.sources[2]);
+	}
+	pending.numSources = desc.geometryPath.empty() ? 2 : 3;
+	for (uint32_t i = 0; i < pending.numSources; i++) {
+		pending.sources[i] = injectDefines(pending.sources[i], desc.defines);
+	}
+
+	const auto start = Clock::now();
 	id_ = glCreateProgram();
-	glAttachShader(id_, vertex);
-	glAttachShader(id_, fragment);
-	if (geometryPath) {
-		glAttachShader(id_, geometry);
+	const bool cached = !g_ProgramCacheDir.empty() && glExtensions().programBinary;
+	pending.key = cached ? programKey(pending.sources, pending.numSources) : 0;
+	pending.fromBinary = cached && loadBinary(binaryPath(pending.key), pending.key);
+	if (!pending.fromBinary) submit(pending);
+	pending.ms = elapsedMs(start);
+
+	if (mode == ShaderCompile::Blocking) finish();
+}
+
+std::vector<std::unique_ptr<Shader>> Shader::compileBatch(const std::vector<ShaderDesc>& programs) {
+	std::vector<std::unique_ptr<Shader>> shaders;
+	shaders.reserve(programs.size());
+	for (const ShaderDesc& desc : programs) {
+		shaders.emplace_back(new Shader(desc, ShaderCompile::Deferred));
+	}
+	return shaders;
+}
+
+bool Shader::ready() const {
+	if (!pending_) return true;
+	if (glExtensions().parallelShaderCompile) {
+		int32_t done = 0;
+		glGetProgramiv(id_, GL_COMPLETION_STATUS_KHR, &done);
+		if (!done) return false;
+	}
+	finish();
+	return true;
+}
+
+void Shader::finish() const {
+	if (!pending_) return;
+	Pending& pending = *pending_;
+	const auto start = Clock::now();
+
+	int32_t linked = 0;
+	if (pending.fromBinary) {
+		glGetProgramiv(id_, GL_LINK_STATUS, &linked);
+		if (!linked) {
+			// Drivers refuse binaries after an update or a settings change, the sources are compiled instead
+			g_ProgramCacheStats.rejected++;
+			pending.fromBinary = false;
+			submit(pending);
+		}
+	}
+
+	if (pending.fromBinary) {
+		g_ProgramCacheStats.hits++;
+		g_ProgramCacheStats.loadMs += pending.ms + elapsedMs(start);
+	}
+	else {
+		const Type types[3] = { Type::Vertex, Type::Fragment, Type::Geometry };
+		for (uint32_t i = 0; i < pending.numSources; i++) {
+			checkErrors(pending.shaders[i], types[i]);
+		}
+		const bool success = checkErrors(id_, Type::Program);
+		for (uint32_t i = 0; i < pending.numSources; i++) {
+			glDetachShader(id_, pending.shaders[i]);
+			if (pending.ownsStages) glDeleteShader(pending.shaders[i]);
+		}
+		if (success && pending.key) storeBinary(binaryPath(pending.key), pending.key);
+		g_ProgramCacheStats.misses++;
+		g_ProgramCacheStats.compileMs += pending.ms + elapsedMs(start);
+	}
+
+	pending_.reset();
+	reflectUniforms();
+}
+
+void Shader::submit(Pending& pending) const {
+	const GLenum stages[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+
+	// No status queries here, they would make the driver finish the compile on this thread
+	pending.ownsStages = !g_StageSharing;
+	for (uint32_t i = 0; i < pending.numSources; i++) {
+		const uint64_t key = hashString(pending.sources[i].c_str(), hashBytes(&stages[i], sizeof(GLenum), k_FNVOffset));
+		auto found = g_StageSharing ? g_Stages.find(key) : g_Stages.end();
+		if (found != g_Stages.end()) {
+			pending.shaders[i] = found->second;
+			g_ProgramCacheStats.stagesShared++;
+		}
+		else {
+			const char* code = pending.sources[i].c_str();
+			pending.shaders[i] = glCreateShader(stages[i]);
+			glShaderSource(pending.shaders[i], 1, &code, NULL);
+			glCompileShader(pending.shaders[i]);
+			g_ProgramCacheStats.stagesCompiled++;
+			if (g_StageSharing) g_Stages[key] = pending.shaders[i];
+		}
+		glAttachShader(id_, pending.shaders[i]);
+	}
+
+	if (pending.key) {
+		glExtensions().programParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	}
 	glLinkProgram(id_);
-	
-	checkErrors(id_, Type::Program);
-	
-	glDeleteShader(vertex);
-	glDeleteShader(fragment);
-	if (geometryPath) {
-		glDeleteShader(geometry);
+}
+
+bool Shader::loadBinary(const std::string& path, const uint64_t key) const {
+	std::ifstream file(path, std::ios_base::binary);
+	if (!file) return false;
+
+	BinaryHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		std::memcmp(header.magic, k_BinaryMagic, sizeof(k_BinaryMagic)) != 0 ||
+		header.version != k_BinaryVersion || header.key != key) {
+		return false;
 	}
+	std::vector<char> binary(header.length);
+	if (!file.read(binary.data(), binary.size())) return false;
+
+	// Whether the driver accepted it is only checked in finish()
+	glExtensions().programBinaryLoad(id_, header.format, binary.data(), header.length);
+	return true;
+}
+
+void Shader::storeBinary(const std::string& path, const uint64_t key) const {
+	if (!g_ProgramCacheDirReady) {
+		g_ProgramCacheDirReady = makeDirectory(g_ProgramCacheDir);
+		if (!g_ProgramCacheDirReady) {
+			std::cout << "Error creating Shader cache directory: " << g_ProgramCacheDir << std::endl;
+			return;
+		}
+	}
+
+	int32_t length = 0;
+	glGetProgramiv(id_, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) return;
+	std::vector<char> binary(length);
+	BinaryHeader header;
+	std::memcpy(header.magic, k_BinaryMagic, sizeof(k_BinaryMagic));
+	header.version = k_BinaryVersion;
+	header.key = key;
+	GLenum format = 0;
+	glExtensions().getProgramBinary(id_, length, &length, &format, binary.data());
+	header.format = format;
+	header.length = static_cast<uint32_t>(length);
+
+	// Written aside and renamed, so a crash never leaves a truncated binary behind
+	const std::string tmpPath = path + ".tmp";
+	std::ofstream out(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(binary.data(), header.length);
+	out.close();
+	if (!out) {
+		std::remove(tmpPath.c_str());
+		return;
+	}
+	std::remove(path.c_str());
+	std::rename(tmpPath.c_str(), path.c_str());
+}
+
+void Shader::setProgramCacheDir(const std::string& dir) {
+	g_ProgramCacheDir = dir;
+	g_ProgramCacheDirReady = false;
+}
+
+const std::string& Shader::programCacheDir() {
+	return g_ProgramCacheDir;
+}
+
+const ProgramCacheStats& Shader::programCacheStats() {
+	return g_ProgramCacheStats;
+}
+
+void Shader::resetProgramCacheStats() {
+	g_ProgramCacheStats = ProgramCacheStats();
+}
+
+void Shader::setStageSharing(const bool enabled) {
+	g_StageSharing = enabled;
+}
+
+void Shader::clearStageCache() {
+	// Programs linked from them keep working, GL frees attached stages once detached
+	for (const auto& stage : g_Stages) {
+		glDeleteShader(stage.second);
+	}
+	g_Stages.clear();
 }
 
 Shader::~Shader() {
+	if (pending_ && !pending_->fromBinary && pending_->ownsStages) {
+		for (uint32_t i = 0; i < pending_->numSources; i++) {
+			glDeleteShader(pending_->shaders[i]);
+		}
+	}
+	GLState::instance().forgetProgram(id_);
 	glDeleteProgram(id_);
 }
 
 void Shader::use() const {
-	glUseProgram(id_);
+	finish();
+	GLState::instance().useProgram(id_);
+}
+
+ShaderVariants::ShaderVariants(const char* vertexPath, const char* fragmentPath, const char* geometryPath) :
+	desc_(describe(vertexPath, fragmentPath, geometryPath)) {}
+
+const Shader& ShaderVariants::get(const ShaderDefines& defines, const ShaderCompile mode) {
+	std::unique_ptr<Shader>& variant = variants_[hashDefines(defines, k_FNVOffset)];
+	if (!variant) {
+		ShaderDesc desc = desc_;
+		desc.defines = defines;
+		variant.reset(new Shader(desc, mode));
+	}
+	return *variant;
+}
+
+ShaderLibrary& ShaderLibrary::instance() {
+	static ShaderLibrary library;
+	return library;
+}
+
+std::shared_ptr<const Shader> ShaderLibrary::get(const char* vertexPath, const char* fragmentPath, const char* geometryPath) {
+	return get(describe(vertexPath, fragmentPath, geometryPath));
+}
+
+std::shared_ptr<const Shader> ShaderLibrary::get(const ShaderDesc& desc, const ShaderCompile mode) {
+	uint64_t key = hashString(TextureCache::normalizePath(desc.vertexPath).c_str(), k_FNVOffset);
+	key = hashString(TextureCache::normalizePath(desc.fragmentPath).c_str(), key);
+	key = hashString(desc.geometryPath.empty() ? "" : TextureCache::normalizePath(desc.geometryPath).c_str(), key);
+	key = hashDefines(desc.defines, key);
+
+	std::weak_ptr<const Shader>& entry = programs_[key];
+	std::shared_ptr<const Shader> program = entry.lock();
+	if (program) {
+		hits_++;
+		return program;
+	}
+	misses_++;
+	program = std::make_shared<const Shader>(desc, mode);
+	entry = program;
+	return program;
+}
+
+size_t ShaderLibrary::size() const {
+	size_t live = 0;
+	for (const auto& entry : programs_) {
+		if (!entry.second.expired()) live++;
+	}
+	return live;
 }
 
 void Shader::loadShader(const char* path, std::string* code) const
@@ -80,58 +416,222 @@ void Shader::loadShader(const char* path, std::string* code) const
 	}
 }
 
+namespace {
+	UniformStats g_UniformStats;
+
+	// Uniform blocks shared between programs and their fixed binding points
+	struct BlockBinding {
+		const char* name;
+		uint32_t binding;
+	};
+	const BlockBinding k_BlockBindings[] = {
+		{ k_FrameBlockName, k_FrameBlockBinding },
+		{ k_LightsBlockName, k_LightsBlockBinding },
+		{ k_MaterialBlockName, k_MaterialBlockBinding },
+		{ k_ObjectBlockName, k_ObjectBlockBinding }
+	};
+
+	// Samplers of shared buffers and the texture units they are bound to
+	const BlockBinding k_SamplerBindings[] = {
+		{ k_PointLightSamplerName, k_PointLightTextureUnit }
+	};
+}
+
+void Shader::reflectUniforms() const {
+	for (const BlockBinding& block : k_BlockBindings) {
+		const uint32_t index = glGetUniformBlockIndex(id_, block.name);
+		if (index != GL_INVALID_INDEX) glUniformBlockBinding(id_, index, block.binding);
+	}
+
+	int32_t count = 0, maxLength = 0;
+	glGetProgramiv(id_, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(id_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+	std::vector<char> buffer(maxLength + 1);
+
+	auto add = [this](const std::string& name, const int32_t location) {
+		const uint32_t hash = uniformHash(name.c_str());
+		if (slots_.count(hash)) {
+			std::cout << "Error: uniform name hash collision on " << name << std::endl;
+			return;
+		}
+		const Slot slot = { static_cast<int32_t>(uniforms_.size()), name };
+		slots_[hash] = slot;
+		Uniform uniform;
+		uniform.location = location;
+		uniforms_.push_back(uniform);
+	};
+
+	for (int32_t i = 0; i < count; i++) {
+		int32_t size = 0;
+		uint32_t type = 0;
+		glGetActiveUniform(id_, i, maxLength, nullptr, &size, &type, buffer.data());
+		const std::string name(buffer.data());
+		const int32_t location = glGetUniformLocation(id_, name.c_str());
+		if (location < 0) continue; // member of a uniform block
+
+		// Arrays are reported once as "name[0]", every element gets its own entry
+		const size_t bracket = name.size() > 3 ? name.rfind("[0]") : std::string::npos;
+		if (bracket == std::string::npos || bracket != name.size() - 3) {
+			add(name, location);
+			continue;
+		}
+		const std::string base = name.substr(0, bracket);
+		for (int32_t element = 0; element < size; element++) {
+			const std::string elementName = base + '[' + std::to_string(element) + ']';
+			add(elementName, glGetUniformLocation(id_, elementName.c_str()));
+		}
+		// The bare name is the same GL location as name[0], so it shares its slot and shadow value
+		const uint32_t baseHash = uniformHash(base.c_str());
+		const auto first = slots_.find(uniformHash(name.c_str()));
+		if (slots_.count(baseHash))
+			std::cout << "Error: uniform name hash collision on " << base << std::endl;
+		else if (first != slots_.end()) {
+			const Slot slot = { first->second.uniform, base };
+			slots_[baseHash] = slot;
+		}
+	}
+
+	// Sampler uniforms only take a value while their program is current
+	for (const BlockBinding& sampler : k_SamplerBindings) {
+		const UniformHandle handle = uniform(sampler.name);
+		if (handle.slot < 0) continue;
+		int32_t current = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+		glUseProgram(id_);
+		set(handle, static_cast<int>(sampler.binding));
+		glUseProgram(current);
+	}
+}
+
+UniformHandle Shader::uniform(const char* name) const {
+	return uniform(UniformName(name));
+}
+
+UniformHandle Shader::uniform(const UniformName name) const {
+	finish();
+	UniformHandle handle;
+	auto found = slots_.find(name.hash);
+	if (found != slots_.end() && found->second.name == name.name) handle.slot = found->second.uniform;
+	return handle;
+}
+
+const UniformStats& Shader::uniformStats() {
+	return g_UniformStats;
+}
+
+void Shader::resetUniformStats() {
+	g_UniformStats = UniformStats();
+}
+
+bool Shader::changed(const UniformHandle handle, const void* value, const uint32_t size) const {
+	if (handle.slot < 0) return false; // inactive, GL would ignore it too
+	Uniform& uniform = uniforms_[handle.slot];
+	if (uniform.size == size && std::memcmp(uniform.value, value, size) == 0) {
+		g_UniformStats.skipped++;
+		return false;
+	}
+	uniform.size = size;
+	std::memcpy(uniform.value, value, size);
+	g_UniformStats.issued++;
+	return true;
+}
+
 void Shader::set(const char* name, const bool value) const
 {
-	glUniform1i(glGetUniformLocation(id_, name), static_cast<int>(value));
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const int value) const
 {
-	glUniform1i(glGetUniformLocation(id_, name), value);
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const float value) const
 {
-	glUniform1f(glGetUniformLocation(id_, name), value);
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const float value1, const float value2) const {
-	glUniform2f(glGetUniformLocation(id_, name), value1, value2);
+	set(uniform(name), glm::vec2(value1, value2));
 }
 
 void Shader::set(const char* name, const float value1, const float value2, const float value3) const {
-	glUniform3f(glGetUniformLocation(id_, name), value1, value2, value3);
+	set(uniform(name), glm::vec3(value1, value2, value3));
 }
 
 void Shader::set(const char* name, const float value1, const float value2, const float value3, const float value4) const {
-	glUniform4f(glGetUniformLocation(id_, name), value1, value2, value3, value4);
+	set(uniform(name), glm::vec4(value1, value2, value3, value4));
 }
 
 void Shader::set(const char* name, const glm::vec2& value) const {
-	glUniform2fv(glGetUniformLocation(id_, name), 1, glm::value_ptr(value));
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const glm::vec3& value) const {
-	glUniform3fv(glGetUniformLocation(id_, name), 1, glm::value_ptr(value));
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const glm::vec4& value) const {
-	glUniform4fv(glGetUniformLocation(id_, name), 1, glm::value_ptr(value));
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const glm::mat2& value) const {
-	glUniformMatrix2fv(glGetUniformLocation(id_, name), 1, GL_FALSE, glm::value_ptr(value));
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const glm::mat3& value) const {
-	glUniformMatrix3fv(glGetUniformLocation(id_, name), 1, GL_FALSE, glm::value_ptr(value));
+	set(uniform(name), value);
 }
 
 void Shader::set(const char* name, const glm::mat4& value) const {
-	glUniformMatrix4fv(glGetUniformLocation(id_, name), 1, GL_FALSE, glm::value_ptr(value));
+	set(uniform(name), value);
+}
+
+void Shader::set(const UniformHandle handle, const bool value) const {
+	set(handle, static_cast<int>(value));
+}
+
+void Shader::set(const UniformHandle handle, const int value) const {
+	if (changed(handle, &value, sizeof(value)))
+		glUniform1i(uniforms_[handle.slot].location, value);
+}
+
+void Shader::set(const UniformHandle handle, const float value) const {
+	if (changed(handle, &value, sizeof(value)))
+		glUniform1f(uniforms_[handle.slot].location, value);
+}
+
+void Shader::set(const UniformHandle handle, const glm::vec2& value) const {
+	if (changed(handle, glm::value_ptr(value), sizeof(value)))
+		glUniform2fv(uniforms_[handle.slot].location, 1, glm::value_ptr(value));
+}
+
+void Shader::set(const UniformHandle handle, const glm::vec3& value) const {
+	if (changed(handle, glm::value_ptr(value), sizeof(value)))
+		glUniform3fv(uniforms_[handle.slot].location, 1, glm::value_ptr(value));
+}
+
+void Shader::set(const UniformHandle handle, const glm::vec4& value) const {
+	if (changed(handle, glm::value_ptr(value), sizeof(value)))
+		glUniform4fv(uniforms_[handle.slot].location, 1, glm::value_ptr(value));
+}
+
+void Shader::set(const UniformHandle handle, const glm::mat2& value) const {
+	if (changed(handle, glm::value_ptr(value), sizeof(value)))
+		glUniformMatrix2fv(uniforms_[handle.slot].location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::set(const UniformHandle handle, const glm::mat3& value) const {
+	if (changed(handle, glm::value_ptr(value), sizeof(value)))
+		glUniformMatrix3fv(uniforms_[handle.slot].location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::set(const UniformHandle handle, const glm::mat4& value) const {
+	if (changed(handle, glm::value_ptr(value), sizeof(value)))
+		glUniformMatrix4fv(uniforms_[handle.slot].location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
-void Shader::checkErrors(const uint32_t shader, const Type type) const {
+bool Shader::checkErrors(const uint32_t shader, const Type type) const {
 	const int log_size = 512;
 	int success;
 	char log[log_size];
@@ -141,7 +641,7 @@ void Shader::checkErrors(const uint32_t shader, const Type type) const {
 		if (!success) {
 			glGetShaderInfoLog(shader, log_size, nullptr, log);
 			std::cout << "Error compiling Shader: " <<
-				((type == Type::Vertex) ? "Vertex" : "Fragment") << std::endl << log << std::endl;
+				((type == Type::Vertex) ? "Vertex" : (type == Type::Fragment) ? "Fragment" : "Geometry") << std::endl << log << std::endl;
 		}
 	}
 	else {
@@ -151,4 +651,5 @@ void Shader::checkErrors(const uint32_t shader, const Type type) const {
 			std::cout << "Error linking Shader Program: " << std::endl << log << std::endl;
 		}
 	}
+	return success != 0;
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "stream_buffer.h"
+#include "gl_extensions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+	typedef std::chrono::high_resolution_clock Clock;
+
+	const GLuint64 k_WaitTimeout = 1000000; // 1 ms per glClientWaitSync, repeated until signalled
+}
+
+ObjectData objectData(const glm::mat4& model) {
+	const glm::mat3 normalMat = glm::transpose(glm::inverse(glm::mat3(model)));
+	ObjectData data;
+	data.model = model;
+	for (uint32_t i = 0; i < 3; i++) data.normalMat[i] = glm::vec4(normalMat[i], 0.0f);
+	return data;
+}
+
+StreamBuffer::StreamBuffer(const uint32_t target, const size_t frameBytes, const uint32_t frames, const Mode mode) :
+	target_(target),
+	frameBytes_(frameBytes),
+	frames_(std::max(frames, 1u)),
+	mode_(mode == Mode::Persistent && glExtensions().bufferStorage ? Mode::Persistent : Mode::Orphaning),
+	fences_(frames_, nullptr),
+	frame_(frames_ - 1) // the first beginFrame() starts at region 0
+{
+	if (target_ == GL_UNIFORM_BUFFER) {
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		alignment_ = std::max<size_t>(alignment_, alignment);
+	}
+
+	glGenBuffers(1, &buffer_);
+	glBindBuffer(target_, buffer_);
+	if (mode_ == Mode::Persistent) {
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glExtensions().createBufferStorage(target_, frameBytes_ * frames_, nullptr, flags);
+		mapped_ = static_cast<uint8_t*>(glMapBufferRange(target_, 0, frameBytes_ * frames_, flags));
+		if (!mapped_) {
+			std::cout << "ERROR::STREAMBUFFER:: Persistent mapping failed, orphaning instead" << std::endl;
+			glBindBuffer(target_, 0);
+			glDeleteBuffers(1, &buffer_);
+			glGenBuffers(1, &buffer_);
+			glBindBuffer(target_, buffer_);
+			mode_ = Mode::Orphaning;
+		}
+	}
+	if (mode_ == Mode::Orphaning) {
+		glBufferData(target_, frameBytes_, nullptr, GL_STREAM_DRAW);
+		staging_.resize(frameBytes_);
+	}
+	glBindBuffer(target_, 0);
+}
+
+StreamBuffer::~StreamBuffer() {
+	for (void* fence : fences_) {
+		if (fence) glDeleteSync(static_cast<GLsync>(fence));
+	}
+	if (mapped_) {
+		glBindBuffer(target_, buffer_);
+		glUnmapBuffer(target_);
+		glBindBuffer(target_, 0);
+	}
+	glDeleteBuffers(1, &buffer_);
+}
+
+void StreamBuffer::beginFrame() {
+	frame_ = (frame_ + 1) % frames_;
+	if (mode_ == Mode::Persistent) {
+		GLsync fence = static_cast<GLsync>(fences_[frame_]);
+		if (fence) {
+			if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+				const Clock::time_point start = Clock::now();
+				GLenum result;
+				do {
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, k_WaitTimeout);
+				} while (result == GL_TIMEOUT_EXPIRED);
+				stats_.waits++;
+				stats_.waitMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			}
+			glDeleteSync(fence);
+			fences_[frame_] = nullptr;
+		}
+		head_ = frame_ * frameBytes_;
+	}
+	else {
+		// New storage for this frame, draws still queued keep reading the old one
+		glBindBuffer(target_, buffer_);
+		glBufferData(target_, frameBytes_, nullptr, GL_STREAM_DRAW);
+		glBindBuffer(target_, 0);
+		head_ = 0;
+	}
+	end_ = head_ + frameBytes_;
+	flushed_ = head_;
+}
+
+StreamAllocation StreamBuffer::allocate(const size_t bytes) {
+	const size_t offset = (head_ + alignment_ - 1) / alignment_ * alignment_;
+	if (offset + bytes > end_) {
+		stats_.overflows++;
+		const StreamAllocation full = { nullptr, 0 };
+		return full;
+	}
+	head_ = offset + bytes;
+	stats_.bytes += bytes;
+	const StreamAllocation allocation = { mode_ == Mode::Persistent ? mapped_ + offset : staging_.data() + offset, offset };
+	return allocation;
+}
+
+void StreamBuffer::flush() {
+	if (mode_ == Mode::Orphaning && head_ > flushed_) {
+		glBindBuffer(target_, buffer_);
+		glBufferSubData(target_, flushed_, head_ - flushed_, staging_.data() + flushed_);
+		glBindBuffer(target_, 0);
+	}
+	flushed_ = head_;
+}
+
+void StreamBuffer::endFrame() {
+	if (mode_ == Mode::Persistent) {
+		fences_[frame_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
+
+void StreamBuffer::bindRange(const uint32_t binding, const size_t offset, const size_t bytes) const {
+	glBindBufferRange(target_, binding, buffer_, offset, bytes);
+}
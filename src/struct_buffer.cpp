@@ -0,0 +1,60 @@
+#include "struct_buffer.h"
+#include "gl_state.h"
+
+#include <iostream>
+
+#include <glad/glad.h>
+
+StructBuffer::StructBuffer(const Storage storage, const uint32_t binding, const size_t capacity) :
+	storage_(storage),
+	binding_(binding),
+	capacity_(capacity)
+{
+	const GLenum target = (storage_ == Storage::UniformBlock) ? GL_UNIFORM_BUFFER : GL_TEXTURE_BUFFER;
+	glGenBuffers(1, &buffer_);
+	glBindBuffer(target, buffer_);
+	glBufferData(target, capacity_, nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(target, 0);
+
+	if (storage_ == Storage::TextureBuffer) {
+		glGenTextures(1, &texture_);
+		GLState::instance().bindTexture(binding_, GL_TEXTURE_BUFFER, texture_);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, buffer_);
+	}
+	bind();
+}
+
+StructBuffer::~StructBuffer() {
+	if (texture_) GLState::instance().forgetTexture(texture_);
+	glDeleteTextures(1, &texture_);
+	glDeleteBuffers(1, &buffer_);
+}
+
+void StructBuffer::uploadBytes(const void* data, const size_t bytes, const size_t offset) const {
+	if (offset + bytes > capacity_) {
+		std::cout << "ERROR::STRUCTBUFFER:: Upload of " << bytes << " bytes at " << offset
+			<< " exceeds the capacity of " << capacity_ << std::endl;
+		return;
+	}
+	const GLenum target = (storage_ == Storage::UniformBlock) ? GL_UNIFORM_BUFFER : GL_TEXTURE_BUFFER;
+	glBindBuffer(target, buffer_);
+	glBufferSubData(target, offset, bytes, data);
+	glBindBuffer(target, 0);
+}
+
+void StructBuffer::bind() const {
+	if (storage_ == Storage::UniformBlock) {
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding_, buffer_);
+	}
+	else {
+		GLState& state = GLState::instance();
+		state.bindTexture(binding_, GL_TEXTURE_BUFFER, texture_);
+		state.activeTexture(0);
+	}
+}
+
+size_t StructBuffer::maxUniformBlockSize() {
+	GLint size = 0;
+	glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &size);
+	return static_cast<size_t>(size);
+}
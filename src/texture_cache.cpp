@@ -0,0 +1,125 @@
+#include "texture_cache.h"
+#include "texture_loader.h"
+#include "gl_state.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <climits>
+#endif
+
+SharedTexture::SharedTexture(const uint32_t id, const size_t bytes, const uint64_t contentHash) :
+	id_(id),
+	bytes_(bytes),
+	contentHash_(contentHash)
+{
+}
+
+SharedTexture::~SharedTexture() {
+	TextureCache::instance().release(this);
+	GLState::instance().forgetTexture(id_);
+	glDeleteTextures(1, &id_);
+}
+
+TextureCache& TextureCache::instance() {
+	static TextureCache cache;
+	return cache;
+}
+
+std::string TextureCache::normalizePath(const std::string& path) {
+	std::string result = path;
+#ifdef _WIN32
+	char buffer[_MAX_PATH];
+	if (_fullpath(buffer, path.c_str(), _MAX_PATH)) result = buffer;
+	std::replace(result.begin(), result.end(), '\\', '/');
+	std::transform(result.begin(), result.end(), result.begin(),
+		[](unsigned char c) { return static_cast<char>(std::tolower(c)); }); // case-insensitive file system
+#else
+	char* resolved = realpath(path.c_str(), nullptr);
+	if (resolved) {
+		result = resolved;
+		free(resolved);
+	}
+#endif
+	return result;
+}
+
+TextureHandle TextureCache::find(const std::string& path) {
+	TextureHandle texture;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto found = byPath_.find(path);
+		if (found != byPath_.end()) texture = found->second.lock();
+	}
+	if (texture) hits_++;
+	else misses_++;
+	return texture;
+}
+
+TextureHandle TextureCache::insert(const std::string& path, DecodedImage& image, double* uploadMs,
+	double* mipmapMs) {
+	TextureHandle texture; // only ever released outside the lock, see release()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto found = byPath_.find(path);
+		if (found != byPath_.end()) texture = found->second.lock();
+
+		if (!texture && contentHashing_ && image.contentHash) { // same image under another path
+			auto content = byContent_.find(image.contentHash);
+			if (content != byContent_.end()) texture = content->second.lock();
+			if (texture) {
+				texture->keys_.push_back(path);
+				byPath_[path] = texture;
+			}
+		}
+	}
+	if (texture) {
+		releaseImage(image);
+		if (uploadMs) *uploadMs = 0.0;
+		if (mipmapMs) *mipmapMs = 0.0;
+		return texture;
+	}
+
+	// Pixels plus the mip chain
+	const size_t bytes = image.pixels ?
+		static_cast<size_t>(image.width) * image.height * image.components * 4 / 3 : 0;
+	const uint64_t contentHash = image.contentHash;
+	const uint32_t id = uploadTexture(image, uploadMs, mipmapMs);
+	texture = std::make_shared<SharedTexture>(id, bytes, contentHash);
+	texture->keys_.push_back(path);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		byPath_[path] = texture;
+		if (contentHash) byContent_[contentHash] = texture;
+	}
+	residentBytes_ += texture->bytes_;
+	residentTextures_++;
+	return texture;
+}
+
+TextureCacheStats TextureCache::stats() const {
+	TextureCacheStats stats;
+	stats.hits = hits_;
+	stats.misses = misses_;
+	stats.residentBytes = residentBytes_;
+	stats.residentTextures = residentTextures_;
+	return stats;
+}
+
+void TextureCache::release(SharedTexture* texture) {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const std::string& key : texture->keys_) {
+			auto found = byPath_.find(key);
+			if (found != byPath_.end() && found->second.expired()) byPath_.erase(found);
+		}
+		auto content = byContent_.find(texture->contentHash_);
+		if (content != byContent_.end() && content->second.expired()) byContent_.erase(content);
+	}
+	residentBytes_ -= texture->bytes_;
+	residentTextures_--;
+}
@@ -0,0 +1,85 @@
+#include "texture_loader.h"
+#include "gl_state.h"
+
+#include <stb_image.h>
+#include <glad/glad.h>
+
+#include <chrono>
+#include <iostream>
+
+DecodedImage decodeImage(const std::string& path, const bool hashContent) {
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	DecodedImage image;
+	image.path = path;
+	image.pixels = stbi_load(path.c_str(), &image.width, &image.height, &image.components, 0);
+
+	if (hashContent && image.pixels) { // FNV-1a over size and pixels
+		const size_t size = static_cast<size_t>(image.width) * image.height * image.components;
+		uint64_t hash = 14695981039346656037ULL;
+		const int32_t dims[3] = { image.width, image.height, image.components };
+		const uint8_t* header = reinterpret_cast<const uint8_t*>(dims);
+		for (size_t i = 0; i < sizeof(dims); i++) hash = (hash ^ header[i]) * 1099511628211ULL;
+		for (size_t i = 0; i < size; i++) hash = (hash ^ image.pixels[i]) * 1099511628211ULL;
+		image.contentHash = hash;
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	image.decodeMs = std::chrono::duration<double, std::milli>(end - start).count();
+	return image;
+}
+
+uint32_t uploadTexture(DecodedImage& image, double* uploadMs, double* mipmapMs) {
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	uint32_t textureID;
+	glGenTextures(1, &textureID);
+	if (mipmapMs) *mipmapMs = 0.0;
+
+	if (image.pixels)
+	{
+		GLenum format = GL_RGB;
+		if (image.components == 1)
+		{
+			format = GL_RED;
+		}
+		else if (image.components == 2)
+		{
+			format = GL_RG;
+		}
+		else if (image.components == 4)
+		{
+			format = GL_RGBA;
+		}
+
+		GLState::instance().bindTexture(0, GL_TEXTURE_2D, textureID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // rows of 1 and 3 component images are not 4-byte aligned
+		glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.pixels);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		const auto mipmapStart = std::chrono::high_resolution_clock::now();
+		glGenerateMipmap(GL_TEXTURE_2D);
+		const auto mipmapEnd = std::chrono::high_resolution_clock::now();
+		if (mipmapMs) *mipmapMs = std::chrono::duration<double, std::milli>(mipmapEnd - mipmapStart).count();
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		stbi_image_free(image.pixels);
+		image.pixels = nullptr;
+	}
+	else
+	{
+		std::cout << "Texture failed to load at path: " << image.path << std::endl;
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	if (uploadMs) *uploadMs = std::chrono::duration<double, std::milli>(end - start).count();
+	return textureID;
+}
+
+void releaseImage(DecodedImage& image) {
+	stbi_image_free(image.pixels);
+	image.pixels = nullptr;
+}
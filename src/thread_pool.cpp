@@ -0,0 +1,37 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(const uint32_t threads) {
+	uint32_t count = threads ? threads : std::thread::hardware_concurrency();
+	if (count == 0) count = 2;
+	for (uint32_t i = 0; i < count; i++)
+		workers_.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	condition_.notify_all();
+	for (std::thread& worker : workers_)
+		worker.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::workerLoop() {
+	for (;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+			if (stopping_ && tasks_.empty()) return;
+			task = std::move(tasks_.front());
+			tasks_.pop();
+		}
+		task();
+	}
+}
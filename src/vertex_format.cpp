@@ -0,0 +1,168 @@
+#include "vertex_format.h"
+#include "mesh.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/packing.hpp>
+
+#include <cstring>
+
+static_assert(sizeof(PackedVertex) == 24, "PackedVertex must stay tightly packed");
+static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex must stay tightly packed");
+
+namespace {
+	float signNotZero(const float v) {
+		return (v >= 0.0f) ? 1.0f : -1.0f;
+	}
+
+	// Maps a unit vector onto the octahedron and unfolds it to [-1, 1]^2
+	glm::vec2 octEncode(const glm::vec3& v) {
+		const float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+		if (l1 == 0.0f) return glm::vec2(0.0f);
+		glm::vec2 p = glm::vec2(v.x, v.y) / l1;
+		if (v.z < 0.0f) {
+			p = glm::vec2((1.0f - std::abs(p.y)) * signNotZero(p.x),
+				(1.0f - std::abs(p.x)) * signNotZero(p.y));
+		}
+		return p;
+	}
+
+	void packFrame(const Vertex& vertex, int16_t normal[2], int16_t tangent[2], uint16_t texCoords[2]) {
+		const glm::vec2 n = octEncode(vertex.Normal);
+		const glm::vec2 t = octEncode(vertex.Tangent);
+		normal[0] = static_cast<int16_t>(glm::packSnorm1x16(n.x));
+		normal[1] = static_cast<int16_t>(glm::packSnorm1x16(n.y));
+		tangent[0] = static_cast<int16_t>(glm::packSnorm1x16(t.x));
+		tangent[1] = static_cast<int16_t>(glm::packSnorm1x16(t.y));
+
+		const bool negative = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f;
+		tangent[1] = static_cast<int16_t>((tangent[1] & ~1) | (negative ? 1 : 0));
+
+		texCoords[0] = glm::packHalf1x16(vertex.TexCoords.x);
+		texCoords[1] = glm::packHalf1x16(vertex.TexCoords.y);
+	}
+}
+
+uint32_t vertexStride(const VertexFormat format) {
+	switch (format) {
+		case VertexFormat::Packed: return sizeof(PackedVertex);
+		case VertexFormat::PackedQuantized: return sizeof(QuantizedVertex);
+		default: return sizeof(Vertex);
+	}
+}
+
+PositionQuantization positionQuantization(const Vertex* vertices, const uint32_t numVertices, const VertexFormat format) {
+	PositionQuantization quantization = { glm::vec3(1.0f), glm::vec3(0.0f) };
+	if (format != VertexFormat::PackedQuantized || numVertices == 0) return quantization;
+
+	glm::vec3 min = vertices[0].Position, max = vertices[0].Position;
+	for (uint32_t i = 1; i < numVertices; i++) {
+		min = glm::min(min, vertices[i].Position);
+		max = glm::max(max, vertices[i].Position);
+	}
+	quantization.scale = max - min;
+	quantization.bias = min;
+	return quantization;
+}
+
+void packVertices(const Vertex* vertices, const uint32_t numVertices, const VertexFormat format,
+	std::vector<uint8_t>* packed) {
+	packed->resize(static_cast<size_t>(numVertices) * vertexStride(format));
+	if (format == VertexFormat::Full) {
+		if (numVertices) std::memcpy(packed->data(), vertices, packed->size());
+		return;
+	}
+
+	if (format == VertexFormat::Packed) {
+		PackedVertex* out = reinterpret_cast<PackedVertex*>(packed->data());
+		for (uint32_t i = 0; i < numVertices; i++) {
+			out[i].Position = vertices[i].Position;
+			packFrame(vertices[i], out[i].Normal, out[i].Tangent, out[i].TexCoords);
+		}
+		return;
+	}
+
+	const PositionQuantization quantization = positionQuantization(vertices, numVertices, format);
+	QuantizedVertex* out = reinterpret_cast<QuantizedVertex*>(packed->data());
+	for (uint32_t i = 0; i < numVertices; i++) {
+		for (uint32_t c = 0; c < 3; c++) {
+			const float range = quantization.scale[c];
+			const float unit = (range > 0.0f) ? (vertices[i].Position[c] - quantization.bias[c]) / range : 0.0f;
+			out[i].Position[c] = glm::packUnorm1x16(unit);
+		}
+		out[i].Position[3] = 0;
+		packFrame(vertices[i], out[i].Normal, out[i].Tangent, out[i].TexCoords);
+	}
+}
+
+uint32_t indexSize(const size_t numVertices) {
+	return numVertices <= 0xFFFF ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+void packIndices(const uint32_t* indices, const uint32_t numIndices, const uint32_t indexSize,
+	std::vector<uint8_t>* packed) {
+	packed->resize(static_cast<size_t>(numIndices) * indexSize);
+	if (indexSize == sizeof(uint32_t)) {
+		if (numIndices) std::memcpy(packed->data(), indices, packed->size());
+		return;
+	}
+	uint16_t* out = reinterpret_cast<uint16_t*>(packed->data());
+	for (uint32_t i = 0; i < numIndices; i++)
+		out[i] = static_cast<uint16_t>(indices[i]);
+}
+
+void setupVertexAttributes(const VertexFormat format) {
+	if (format == VertexFormat::Full) {
+		// vertex Positions
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+
+		// vertex normals
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+			(void*)offsetof(Vertex, Normal));
+
+		// vertex texture coords
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+			(void*)offsetof(Vertex, TexCoords));
+
+		// vertex tangent
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+			(void*)offsetof(Vertex, Tangent));
+
+		// vertex bitangent
+		glEnableVertexAttribArray(4);
+		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+			(void*)offsetof(Vertex, Bitangent));
+		return;
+	}
+
+	const GLsizei stride = vertexStride(format);
+	const bool quantized = format == VertexFormat::PackedQuantized;
+
+	// vertex Positions: floats, or unorm16 to be scaled by the shader
+	glEnableVertexAttribArray(0);
+	if (quantized)
+		glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(QuantizedVertex, Position));
+	else
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, Position));
+
+	// vertex normals (octahedral, read as vec2 in [-1, 1])
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride,
+		(void*)(quantized ? offsetof(QuantizedVertex, Normal) : offsetof(PackedVertex, Normal)));
+
+	// vertex texture coords (half floats)
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride,
+		(void*)(quantized ? offsetof(QuantizedVertex, TexCoords) : offsetof(PackedVertex, TexCoords)));
+
+	// vertex tangent (octahedral, read as ivec2 to keep the bitangent sign bit)
+	glEnableVertexAttribArray(3);
+	glVertexAttribIPointer(3, 2, GL_SHORT, stride,
+		(void*)(quantized ? offsetof(QuantizedVertex, Tangent) : offsetof(PackedVertex, Tangent)));
+
+	// no bitangent, the shader rebuilds it from the normal, tangent and sign
+	glDisableVertexAttribArray(4);
+}
@@ -9,7 +9,6 @@ out vec4 fragColor;
 struct Material {
     sampler2D diffuse;
     sampler2D specular;
-    float shininess;
 };
 
 struct DirLight {
@@ -32,11 +31,22 @@ struct PointLight {
     float quadratic;
 };
 
-#define NUMBER_POINT_LIGHTS 2
+#ifndef MAX_POINT_LIGHTS
+#define MAX_POINT_LIGHTS 2
+#endif
 
 uniform Material material; 
-uniform DirLight dirLight;
-uniform PointLight pointLights[NUMBER_POINT_LIGHTS];
+
+layout (std140) uniform Lights {
+    DirLight dirLight;
+    int numPointLights;
+    PointLight pointLights[MAX_POINT_LIGHTS];
+};
+
+layout (std140) uniform MaterialParams {
+    float shininess;
+};
+
 uniform vec3 viewPos;
 
 vec3 calcDirectionalLight(DirLight light, vec3 normal, vec3 viewDir) {
@@ -44,7 +54,7 @@ vec3 calcDirectionalLight(DirLight light, vec3 normal, vec3 viewDir) {
     float diff = max(dot(normal, lightDir), 0.0);
 
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
     
     vec3 ambient = light.ambient * vec3(texture(material.diffuse, textCoords));
     vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, textCoords));
@@ -57,7 +67,7 @@ vec3 calcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     vec3 lightDir = normalize(light.position - fragPos);
     float diff = max(dot(normal, lightDir), 0.0);
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
     float distance = length(light.position - fragPos);
     float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
     vec3 ambient = light.ambient * vec3(texture(material.diffuse, textCoords));
@@ -72,10 +82,10 @@ void main() {
     vec3 viewDir = normalize(viewPos - fragPos);
     vec3 color = calcDirectionalLight(dirLight, norm, viewDir);
 
-    for (int i=0; i < NUMBER_POINT_LIGHTS; ++i)
+    for (int i=0; i < MAX_POINT_LIGHTS; ++i)
         color += calcPointLight(pointLights[i], norm, fragPos, viewDir);
 
-    for (int i=0; i < NUMBER_POINT_LIGHTS; ++i)
+    for (int i=0; i < MAX_POINT_LIGHTS; ++i)
         color += calcPointLight(pointLights[i], norm, fragPos, viewDir);
     
     fragColor = vec4(color, 1.0);
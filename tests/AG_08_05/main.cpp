@@ -8,6 +8,7 @@
 #include <iostream>
 #include "shader.h"
 #include "camera.h"
+#include "light_uniforms.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -120,34 +121,9 @@ void render(const uint32_t& VAO, const Shader& shader_cube, const int32_t text_d
 
 	shader_cube.set("viewPos", camera.getPosition());
 
-	// Directional Light
-	shader_cube.set("dirLight.direction", -0.2f, -1.0f, -0.3f);
-	shader_cube.set("dirLight.ambient", 0.01f, 0.01f, 0.01f);
-	shader_cube.set("dirLight.diffuse", 0.15f, 0.15f, 0.15f);
-	shader_cube.set("dirLight.specular", 0.5f, 0.5f, 0.5f);
-
-	// Point Light 1
-	shader_cube.set("pointLights[0].position", pointLightPositions[0]);
-	shader_cube.set("pointLights[0].ambient", 0.05f, 0.05f, 0.05f);
-	shader_cube.set("pointLights[0].diffuse", 0.5f, 0.5f, 0.5f);
-	shader_cube.set("pointLights[0].specular", 1.0f, 1.0f, 1.0f);
-	shader_cube.set("pointLights[0].constant", 1.0f);
-	shader_cube.set("pointLights[0].linear", 0.09f);
-	shader_cube.set("pointLights[0].quadratic", 0.032f);
-
-	// Point Light 2
-	shader_cube.set("pointLights[1].position", pointLightPositions[1]);
-	shader_cube.set("pointLights[1].ambient", 0.05f, 0.05f, 0.05f);
-	shader_cube.set("pointLights[1].diffuse", 0.5f, 0.5f, 0.5f);
-	shader_cube.set("pointLights[1].specular", 1.0f, 1.0f, 1.0f);
-	shader_cube.set("pointLights[1].constant", 1.0f);
-	shader_cube.set("pointLights[1].linear", 0.09f);
-	shader_cube.set("pointLights[1].quadratic", 0.032f);
-
-	// Cube - Material properties
+	// Cube - Material textures, the lights and shininess are in uniform blocks
 	shader_cube.set("material.diffuse", 0);
 	shader_cube.set("material.specular", 1);
-	shader_cube.set("material.shininess", (float) 0.1f * 128);
 
 	// Set text_dif and specular map
 	glActiveTexture(GL_TEXTURE0);
@@ -179,6 +155,32 @@ void render(const uint32_t& VAO, const Shader& shader_cube, const int32_t text_d
 	}
 }
 
+void setLights(LightUniforms& lights)
+{
+	DirLight dirLight = {};
+	dirLight.direction = glm::vec3(-0.2f, -1.0f, -0.3f);
+	dirLight.ambient = glm::vec3(0.01f, 0.01f, 0.01f);
+	dirLight.diffuse = glm::vec3(0.15f, 0.15f, 0.15f);
+	dirLight.specular = glm::vec3(0.5f, 0.5f, 0.5f);
+	lights.setDirLight(dirLight);
+
+	PointLight pointLights[2] = {};
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		pointLights[i].position = pointLightPositions[i];
+		pointLights[i].ambient = glm::vec3(0.05f, 0.05f, 0.05f);
+		pointLights[i].diffuse = glm::vec3(0.5f, 0.5f, 0.5f);
+		pointLights[i].specular = glm::vec3(1.0f, 1.0f, 1.0f);
+		pointLights[i].constant = 1.0f;
+		pointLights[i].linear = 0.09f;
+		pointLights[i].quadratic = 0.032f;
+	}
+	lights.setPointLights(pointLights, 2);
+
+	// Whole block in one upload instead of 4 + 7 per light glUniform calls
+	lights.upload();
+}
+
 uint32_t createVertexData(uint32_t *VBO, uint32_t *EBO)
 {
 	// Whoah! A Cube!
@@ -319,8 +321,21 @@ int main(int argc, char* argv[])
 	glfwSetCursorPosCallback(window, onMouse);
 	glfwSetScrollCallback(window, onScroll);
 
+	// Lights and material parameters
+	LightUniforms lights(2);
+	setLights(lights);
+
+	MaterialParams materialParams = {};
+	materialParams.shininess = 0.1f * 128;
+	StructBuffer material(StructBuffer::Storage::UniformBlock, k_MaterialBlockBinding, sizeof(MaterialParams));
+	material.upload(&materialParams, 1);
+
 	// Create program and vertex data
-	const Shader shader_cube("../tests/AG_08_05/cube.vs", "../tests/AG_08_05/cube.fs");
+	ShaderDesc cubeDesc;
+	cubeDesc.vertexPath = "../tests/AG_08_05/cube.vs";
+	cubeDesc.fragmentPath = "../tests/AG_08_05/cube.fs";
+	cubeDesc.defines = lights.defines();
+	const Shader shader_cube(cubeDesc);
 
 	uint32_t VBO, EBO; // vertex and element buffer objects
 	uint32_t VAO = createVertexData(&VBO, &EBO); // vertex array object
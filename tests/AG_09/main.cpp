@@ -103,11 +103,8 @@ void render(const Shader& shader, Model& object) {
 	glm::mat4 model(1.0f);
 	model = glm::translate(model, glm::vec3(0.0f, -1.75f, 0.0f));
 	model = glm::scale(model, glm::vec3(0.1f, 0.1f, 0.1f));
-	shader.set("model", model);
 
-	object.Draw(shader);
-
-	glBindVertexArray(0);
+	object.Draw(shader, model); // places every node of the model
 }
 
 #pragma endregion
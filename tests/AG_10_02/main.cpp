@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include "shader.h"
+#include "gl_state.h"
 #include "camera.h"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -88,6 +89,8 @@ void onMouse(GLFWwindow* window, double xpos, double ypos)
 }
 
 void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& lightingShader, const Shader& stencilShader, const int32_t text_dif, const uint32_t text_spec) {
+	GLState& state = GLState::instance(); // drops the binds and state changes GL already holds
+
 	glClearColor(0.0f / 255.0f, 0.0f / 255.0f, 0.0f / 255.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
@@ -106,11 +109,9 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	lightingShader.set("material.shininess", 32.0f);
 
 	// Textures
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, text_dif);
+	state.bindTexture(0, GL_TEXTURE_2D, text_dif);
 
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, text_spec);
+	state.bindTexture(1, GL_TEXTURE_2D, text_spec);
 
 
 	// Projection and View
@@ -135,15 +136,15 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
 	lightingShader.set("normalMat", normalMat);
 
-	glStencilMask(0x00); // each bit ends as 0 in the buffer
+	state.stencilMask(0x00); // each bit ends as 0 in the buffer
 
-	glBindVertexArray(quadVAO);
+	state.bindVertexArray(quadVAO);
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
 
 	// FIRST PASS______________________________________________________
 
-	glStencilMask(0xFF); // each bit is written in the buffer
-	glStencilFunc(GL_ALWAYS, 1, 0xFF);
+	state.stencilMask(0xFF); // each bit is written in the buffer
+	state.stencilFunc(GL_ALWAYS, 1, 0xFF);
 
 	// First cube
 	model = glm::mat4(1.0);
@@ -154,7 +155,7 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
 	lightingShader.set("normalMat", normalMat);
 
-	glBindVertexArray(cubeVAO);
+	state.bindVertexArray(cubeVAO);
 	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
 
 	// Second cube
@@ -166,7 +167,7 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
 	lightingShader.set("normalMat", normalMat);
 
-	glBindVertexArray(cubeVAO);
+	state.bindVertexArray(cubeVAO);
 	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
 
 	// Third cube
@@ -178,7 +179,7 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
 	lightingShader.set("normalMat", normalMat);
 
-	glBindVertexArray(cubeVAO);
+	state.bindVertexArray(cubeVAO);
 	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
 
 	
@@ -187,9 +188,9 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	stencilShader.use();
 	stencilShader.set("projection", proj);
 	stencilShader.set("view", view);
-	glStencilMask(0x00);
-	glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
-	glDisable(GL_DEPTH_TEST);
+	state.stencilMask(0x00);
+	state.stencilFunc(GL_NOTEQUAL, 1, 0xFF);
+	state.setDepthTest(false);
 
 	// First cube
 	model = glm::mat4(1.0f);
@@ -200,7 +201,7 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
 	stencilShader.set("normalMat", normalMat);
 
-	glBindVertexArray(cubeVAO);
+	state.bindVertexArray(cubeVAO);
 	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
 
 	// Second cube
@@ -212,7 +213,7 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
 	stencilShader.set("normalMat", normalMat);
 
-	glBindVertexArray(cubeVAO);
+	state.bindVertexArray(cubeVAO);
 	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
 
 	// Third cube
@@ -224,13 +225,13 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
 	stencilShader.set("normalMat", normalMat);
 
-	glBindVertexArray(cubeVAO);
+	state.bindVertexArray(cubeVAO);
 	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
 
-	glBindVertexArray(0); // no need to unbind it every time
+	state.bindVertexArray(0); // no need to unbind it every time
 
-	glStencilMask(0xFF);
-	glEnable(GL_DEPTH_TEST);
+	state.stencilMask(0xFF);
+	state.setDepthTest(true);
 }
 
 uint32_t createVertexData(const float* vertices, const uint32_t n_verts, const uint32_t* indices, const uint32_t n_indices)
@@ -403,17 +404,18 @@ int main(int argc, char* argv[])
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); // NOTE: use GL_LINE to use "WIREFRAME MODE" instead
 
 	// Enable cull faces
-	glEnable(GL_CULL_FACE);
-	glCullFace(GL_BACK); // don't draw back faces
+	GLState& state = GLState::instance();
+	state.setCullFace(true);
+	state.cullFace(GL_BACK); // don't draw back faces
 
 	// Enable Depth Testing 
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS);
+	state.setDepthTest(true);
+	state.depthFunc(GL_LESS);
 
 	// Enable Stencil
-	glEnable(GL_STENCIL_TEST);
-	glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
-	glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+	state.setStencilTest(true);
+	state.stencilFunc(GL_NOTEQUAL, 1, 0xFF);
+	state.stencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 
 	while (!glfwWindowShouldClose(window))
 	{
@@ -7,6 +7,8 @@
 
 #include <iostream>
 #include "shader.h"
+#include "gl_state.h"
+#include "render_queue.h"
 #include "camera.h"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -87,20 +89,10 @@ void onMouse(GLFWwindow* window, double xpos, double ypos)
 	camera.handleMouseMovement(xoffset, yoffset);
 }
 
-void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& lightingShader, const Shader& blendingShader, const int32_t text_dif, const uint32_t text_spec, const uint32_t text_tree) {
+void render(RenderQueue& queue, const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& lightingShader, const Shader& blendingShader, const uint32_t text_dif, const uint32_t text_spec, const uint32_t text_tree) {
 	glClearColor(0.0f / 255.0f, 0.0f / 255.0f, 0.0f / 255.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	// Textures
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, text_dif);
-
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, text_spec);
-
-	glActiveTexture(GL_TEXTURE2);
-	glBindTexture(GL_TEXTURE_2D, text_tree);
-
 	lightingShader.use();
 
 	lightingShader.set("objectColor", 1.0f, 0.5f, 0.31f);
@@ -122,82 +114,53 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const Shader& ligh
 
 	const glm::mat4 view = camera.getViewMatrix();
 
-	// Re-use these:
+	lightingShader.set("projection", proj);
+	lightingShader.set("view", view);
+
+	blendingShader.use();
+	blendingShader.set("projection", proj);
+	blendingShader.set("view", view);
+	blendingShader.set("texture", 0);
+
+	// The queue sets model and normalMat of every draw and orders them: opaque front to back, then the tree
+	queue.begin(view, 0.1f, 100.0f);
+	const uint32_t lit[2] = { text_dif, text_spec };
+
+	// Re-use this:
 	glm::mat4 model;
-	glm::mat3 normalMat;
 
 	// Quad / ground
 	model = glm::mat4(1.0f);
 	model = glm::translate(model, glm::vec3(0.0f, 0.0f, 0.0f));
 	model = glm::scale(model, glm::vec3(3.0f, 1.0f, 3.0f));
-
-	lightingShader.set("projection", proj);
-	lightingShader.set("view", view);
-	lightingShader.set("model", model);
-
-	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
-	lightingShader.set("normalMat", normalMat);
-
-	glBindVertexArray(quadVAO);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+	queue.enqueue(lightingShader, quadVAO, 6, model, RenderPass::Opaque, lit, 2);
 
 	// First cube
 	model = glm::mat4(1.0);
 	model = glm::translate(model, glm::vec3(0.0f, 0.7f, 1.0f));
 	model = glm::scale(model, glm::vec3(0.4f, 0.4f, 0.4f));
-	lightingShader.set("model", model);
-
-	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
-	lightingShader.set("normalMat", normalMat);
-
-	glBindVertexArray(cubeVAO);
-	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+	queue.enqueue(lightingShader, cubeVAO, 36, model, RenderPass::Opaque, lit, 2);
 
 	// Second cube
 	model = glm::mat4(1.0);
 	model = glm::translate(model, glm::vec3(0.0f, 0.7f, 0.0f));
 	model = glm::scale(model, glm::vec3(0.4f, 0.4f, 0.4f));
-	lightingShader.set("model", model);
-
-	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
-	lightingShader.set("normalMat", normalMat);
-
-	glBindVertexArray(cubeVAO);
-	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+	queue.enqueue(lightingShader, cubeVAO, 36, model, RenderPass::Opaque, lit, 2);
 
 	// Third cube
 	model = glm::mat4(1.0);
 	model = glm::translate(model, glm::vec3(0.0f, 0.7f, -1.0f));
 	model = glm::scale(model, glm::vec3(0.4f, 0.4f, 0.4f));
-	lightingShader.set("model", model);
-
-	normalMat = glm::inverse(glm::transpose(glm::mat3(model)));
-	lightingShader.set("normalMat", normalMat);
-
-	glBindVertexArray(cubeVAO);
-	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+	queue.enqueue(lightingShader, cubeVAO, 36, model, RenderPass::Opaque, lit, 2);
 
 	// Quad / tree with alpha blending
-	blendingShader.use();
-
 	glm::mat4 model_tree = glm::mat4(1.0f);
 	model_tree = glm::translate(model_tree, glm::vec3(0.0f, 0.645f, 1.1f));
 	model_tree = glm::scale(model_tree, glm::vec3(0.3f, 0.3f, 0.3f));
 	model_tree = glm::rotate(model_tree, glm::pi<float>() / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+	queue.enqueue(blendingShader, quadVAO, 6, model_tree, RenderPass::Blended, &text_tree, 1);
 
-	blendingShader.set("projection", proj);
-	blendingShader.set("view", view);
-	blendingShader.set("model", model_tree);
-
-	normalMat = glm::inverse(glm::transpose(glm::mat3(model_tree)));
-	blendingShader.set("normalMat", normalMat);
-
-	blendingShader.set("texture", 2);
-
-	glBindVertexArray(quadVAO);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-
-	glBindVertexArray(0); // no need to unbind it every time
+	queue.submit();
 }
 
 uint32_t createVertexData(const float* vertices, const uint32_t n_verts, const uint32_t* indices, const uint32_t n_indices)
@@ -372,16 +335,16 @@ int main(int argc, char* argv[])
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); // NOTE: use GL_LINE to use "WIREFRAME MODE" instead
 
 	// Enable cull faces
-	glEnable(GL_CULL_FACE);
-	glCullFace(GL_BACK); // don't draw back faces
+	GLState& state = GLState::instance();
+	state.setCullFace(true);
+	state.cullFace(GL_BACK); // don't draw back faces
 
 	// Enable Depth Testing 
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS);
+	state.setDepthTest(true);
+	state.depthFunc(GL_LESS);
 
-	// Enable Blending
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// Blending is enabled by the render queue for the transparent quad only
+	RenderQueue queue;
 
 	while (!glfwWindowShouldClose(window))
 	{
@@ -393,7 +356,7 @@ int main(int argc, char* argv[])
 		handleInput(window, deltaTime);
 
 		// Render
-		render(cubeVAO, quadVAO, lightingShader, blendingShader, text_dif, text_spec, text_tree);
+		render(queue, cubeVAO, quadVAO, lightingShader, blendingShader, text_dif, text_spec, text_tree);
 
 		// Swap front and back buffers
 		glfwSwapBuffers(window);
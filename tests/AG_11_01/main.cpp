@@ -8,6 +8,7 @@
 #include <iostream>
 #include "shader.h"
 #include "camera.h"
+#include "gl_state.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -122,19 +123,16 @@ void render(const uint32_t& VAO, const Shader& shader_bump, const int32_t text_d
 	shader_bump.set("material.normal", 2);
 	shader_bump.set("material.shininess", 25.6f);
 
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, text_dif);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, text_dif);
 
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, text_spec);
+	GLState::instance().bindTexture(1, GL_TEXTURE_2D, text_spec);
 
-	glActiveTexture(GL_TEXTURE2);
-	glBindTexture(GL_TEXTURE_2D, text_norm);
+	GLState::instance().bindTexture(2, GL_TEXTURE_2D, text_norm);
 
-	glBindVertexArray(VAO);
+	GLState::instance().bindVertexArray(VAO);
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
 
-	glBindVertexArray(0);
+	GLState::instance().bindVertexArray(0);
 }
 
 uint32_t createQuadVertexData()
@@ -226,7 +224,7 @@ uint32_t createQuadVertexData()
 	glGenBuffers(1, &VBO);
 	glGenBuffers(1, &EBO);
 
-	glBindVertexArray(VAO);
+	GLState::instance().bindVertexArray(VAO);
 
 	// Bind buffers and assign data
 	glBindBuffer(GL_ARRAY_BUFFER, VBO);
@@ -257,7 +255,7 @@ uint32_t createQuadVertexData()
 
 	// Unbind buffers and array
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::instance().bindVertexArray(0);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // NOTE: must happen after unbinding VAO
 
 	return VAO;
@@ -307,7 +305,7 @@ uint32_t createVertexData(uint32_t *VBO, uint32_t *EBO)
 	glGenBuffers(1, VBO);
 	glGenBuffers(1, EBO);
 
-	glBindVertexArray(VAO);
+	GLState::instance().bindVertexArray(VAO);
 
 	// Bind buffers and assign data
 	glBindBuffer(GL_ARRAY_BUFFER, *VBO);
@@ -330,7 +328,7 @@ uint32_t createVertexData(uint32_t *VBO, uint32_t *EBO)
 
 	// Unbind buffers and array
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::instance().bindVertexArray(0);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // NOTE: must happen after unbinding VAO
 
 	return VAO;
@@ -341,7 +339,7 @@ uint32_t createTexture(const char* path)
 	// Generate and bind texture
 	uint32_t texture;
 	glGenTextures(1, &texture);
-	glBindTexture(GL_TEXTURE_2D, texture);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, texture);
 
 	// Texture wrapping
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -420,11 +418,11 @@ int main(int argc, char* argv[])
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); // NOTE: use GL_LINE to use "WIREFRAME MODE" instead
 
 	// Enable cull faces
-	glEnable(GL_CULL_FACE);
-	glCullFace(GL_BACK); // don't draw back faces
+	GLState::instance().setCullFace(true);
+	GLState::instance().cullFace(GL_BACK); // don't draw back faces
 
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS);
+	GLState::instance().setDepthTest(true);
+	GLState::instance().depthFunc(GL_LESS);
 
 	while (!glfwWindowShouldClose(window))
 	{
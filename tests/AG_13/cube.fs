@@ -10,8 +10,18 @@ in vec4 fragPosLightSpace;
 uniform sampler2D diffuseTexture;
 uniform sampler2D depthMap;
 
-uniform vec3 lightPos;
-uniform vec3 viewPos;
+layout (std140) uniform Frame {
+    mat4 projection;
+    mat4 view;
+    mat4 lightSpaceMatrix;
+    vec3 viewPos;
+    vec3 lightPos;
+};
+
+// PCF kernel radius in texels, 0 takes a single sample
+#ifndef PCF_RADIUS
+#define PCF_RADIUS 1
+#endif
 
 float calculateShadow(vec4 fragPosLightSpace, float bias) {
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
@@ -22,13 +32,13 @@ float calculateShadow(vec4 fragPosLightSpace, float bias) {
 
     float shadow = 0.0;
     vec2 texelSize = 1.0 / textureSize(depthMap, 0);
-    for (int x = -1; x <= 1; ++x) {
-        for (int y = -1; y <= 1; ++y) {
+    for (int x = -PCF_RADIUS; x <= PCF_RADIUS; ++x) {
+        for (int y = -PCF_RADIUS; y <= PCF_RADIUS; ++y) {
             float pcfDepth = texture(depthMap, projCoords.xy + vec2(x, y) * texelSize).r;
             shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
         }
     }
-    shadow /= 9.0;
+    shadow /= float((2 * PCF_RADIUS + 1) * (2 * PCF_RADIUS + 1));
 
     if (projCoords.z > 1.0)
         shadow = 0.0;
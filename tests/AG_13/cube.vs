@@ -3,10 +3,21 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTextCoords;
 
+#ifdef INSTANCED
+layout (location = 5) in mat4 aInstanceModel;
+layout (location = 9) in mat3 aInstanceNormalMat;
+#define model aInstanceModel
+#else
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 lightSpaceMatrix;
+#endif
+
+layout (std140) uniform Frame {
+    mat4 projection;
+    mat4 view;
+    mat4 lightSpaceMatrix;
+    vec3 viewPos;
+    vec3 lightPos;
+};
 
 out vec3 normal;
 out vec3 fragPos;
@@ -15,7 +26,11 @@ out vec4 fragPosLightSpace;
 
 void main() {
     fragPos = vec3(model * vec4(aPos, 1.0));
+#ifdef INSTANCED
+    normal = aInstanceNormalMat * aNormal;
+#else
     normal = transpose(inverse(mat3(model))) * aNormal;
+#endif
     textCoords = aTextCoords;
     fragPosLightSpace = lightSpaceMatrix * vec4(fragPos, 1.0);
     
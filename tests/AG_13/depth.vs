@@ -1,8 +1,20 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
+#ifdef INSTANCED
+layout (location = 5) in mat4 aInstanceModel;
+#define model aInstanceModel
+#else
 uniform mat4 model;
-uniform mat4 lightSpaceMatrix;
+#endif
+
+layout (std140) uniform Frame {
+    mat4 projection;
+    mat4 view;
+    mat4 lightSpaceMatrix;
+    vec3 viewPos;
+    vec3 lightPos;
+};
 
 void main() {
     gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
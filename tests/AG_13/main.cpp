@@ -8,6 +8,9 @@
 #include <iostream>
 #include "shader.h"
 #include "camera.h"
+#include "gl_state.h"
+#include "frame_uniforms.h"
+#include "instance_buffer.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -36,6 +39,7 @@ const float shadow_far = 7.5f;
 
 uint32_t shadow_width = 1024;
 uint32_t shadow_height = 1024;
+uint32_t pcf_radius = 1; // keys 0 to 3, each radius is its own shader variant
 
 #pragma region Functions: for Main Loop
 
@@ -70,6 +74,13 @@ void handleInput(GLFWwindow *window, const float dt)
 	{
 		camera.handleKeyboard(Camera::Movement::Right, dt);
 	}
+	for (uint32_t radius = 0; radius <= 3; radius++)
+	{
+		if (glfwGetKey(window, GLFW_KEY_0 + radius) == GLFW_PRESS)
+		{
+			pcf_radius = radius;
+		}
+	}
 
 }
 
@@ -81,11 +92,11 @@ std::pair<uint32_t, uint32_t> createShadowFBO()
 {
 	uint32_t fbo;
 	glGenFramebuffers(1, &fbo);
-	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	GLState::instance().bindFramebuffer(fbo);
 
 	uint32_t depthMap;
 	glGenTextures(1, &depthMap);
-	glBindTexture(GL_TEXTURE_2D, depthMap);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, depthMap);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, shadow_width, shadow_height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
 	
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -97,7 +108,7 @@ std::pair<uint32_t, uint32_t> createShadowFBO()
 	float borderColor[] = {	1.0f, 1.0f, 1.0f, 1.0f };
 	glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
 	
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, 0);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthMap, 0);
 	glDrawBuffer(GL_NONE);
 	glReadBuffer(GL_NONE);
@@ -107,7 +118,7 @@ std::pair<uint32_t, uint32_t> createShadowFBO()
 		std::cout << "Error: FrameBuffer not complete." << std::endl;
 	}
 
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLState::instance().bindFramebuffer(0);
 
 	return std::make_pair(fbo, depthMap);
 }
@@ -129,56 +140,52 @@ void onMouse(GLFWwindow* window, double xpos, double ypos)
 	camera.handleMouseMovement(xoffset, yoffset);
 }
 
-void drawScene(const Shader& shader, const uint32_t cubeVAO, const uint32_t quadVAO, const uint32_t text1, const uint32_t text2) {
+// One instanced draw per VAO, the transforms are already in the instance buffers
+void drawScene(const Shader& shader, const uint32_t cubeVAO, const uint32_t quadVAO, const InstanceBuffer& cubeInstances, const InstanceBuffer& floorInstances, const uint32_t text1, const uint32_t text2) {
 
 	// Floor
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, text1);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, text1);
 
 	shader.set("diffuseTexture", 0);
+	floorInstances.draw(quadVAO, 6);
 
+	// Draw cubes
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, text2);
+	shader.set("diffuseTexture", 0);
+	cubeInstances.draw(cubeVAO, 36);
+}
+
+void createInstances(InstanceBuffer* cubeInstances, InstanceBuffer* floorInstances) {
 	glm::mat4 model = glm::mat4(1.0f);
 	model = glm::translate(model, glm::vec3(10.0f, 0.0f, 0.0f));
-	shader.set("model", model);
+	floorInstances->upload(&model, 1);
 
-	glBindVertexArray(quadVAO);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-
-	// Draw cubes
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, text2);
-	shader.set("diffuseTexture", 0);
+	glm::mat4 models[3];
 
 	// Cube 1
 	model = glm::mat4(1.0f);
 	model = glm::translate(model, glm::vec3(0.0f, 1.5f, 0.0f));
 	model = glm::scale(model, glm::vec3(0.5f));
-	shader.set("model", model);
-	glBindVertexArray(cubeVAO);
-	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+	models[0] = model;
 
 	// Cube 2
 	model = glm::mat4(1.0f);
 	model = glm::translate(model, glm::vec3(0.5f, -0.25f, 0.5f));
 	model = glm::scale(model, glm::vec3(0.5f));
-	shader.set("model", model);
-	glBindVertexArray(cubeVAO);
-	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+	models[1] = model;
 
 	// Cube 3
 	model = glm::mat4(1.0f);
 	model = glm::translate(model, glm::vec3(-1.0f, 0.0f, 2.0f));
 	model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f)));
 	model = glm::scale(model, glm::vec3(0.25f));
-	shader.set("model", model);
-	glBindVertexArray(cubeVAO);
-	glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+	models[2] = model;
 
-	glBindVertexArray(0);
+	cubeInstances->upload(models, 3);
 }
 
-void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const uint32_t& quadScreenVAO, const Shader& lightingShader, const Shader& depthShader, const Shader& debugShader, const int32_t text1, const uint32_t text2,
-	const uint32_t fbo, const uint32_t text_fbo) {
+void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const uint32_t& quadScreenVAO, const InstanceBuffer& cubeInstances, const InstanceBuffer& floorInstances, const Shader& lightingShader, const Shader& depthShader, const Shader& debugShader, const int32_t text1, const uint32_t text2,
+	const uint32_t fbo, const uint32_t text_fbo, FrameUniforms& frame) {
 
 	glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -187,17 +194,21 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const uint32_t& qu
 	const glm::mat4 lightView = glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 	const glm::mat4 lightSpaceMatrix = lightProjection * lightView;
 
+	// Per-frame values, shared by every program through the Frame block
+	frame.setCamera(camera, (float)screen_width / (float)screen_height, 0.1f, 100.0f);
+	frame.setLight(lightPos, lightSpaceMatrix);
+	frame.upload();
+
 	// Shadows
 	depthShader.use();
-	depthShader.set("lightSpaceMatrix", lightSpaceMatrix);
 
-	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	GLState::instance().bindFramebuffer(fbo);
 	glClear(GL_DEPTH_BUFFER_BIT);
 	// glCullFace(GL_FRONT); // sometimes helps to correct Peter-Panning issue
 	glViewport(0, 0, shadow_width, shadow_height);
 	// glCullFace(GL_BACK);
-	drawScene(depthShader, cubeVAO, quadVAO, 0, 0);
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	drawScene(depthShader, cubeVAO, quadVAO, cubeInstances, floorInstances, 0, 0);
+	GLState::instance().bindFramebuffer(0);
 
 	// Lighting
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -205,19 +216,9 @@ void render(const uint32_t& cubeVAO, const uint32_t& quadVAO, const uint32_t& qu
 
 	lightingShader.use();
 
-	const glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), (float)screen_width / (float)screen_height, 0.1f, 100.0f);
-	const glm::mat4 view = camera.getViewMatrix();
-
-	lightingShader.set("projection", projection);
-	lightingShader.set("view", view);
-	lightingShader.set("viewPos", camera.getPosition());
-	lightingShader.set("lightPos", lightPos);
-	lightingShader.set("lightSpaceMatrix", lightSpaceMatrix);
-
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, text_fbo);
+	GLState::instance().bindTexture(1, GL_TEXTURE_2D, text_fbo);
 	lightingShader.set("depthMap", 1);
-	drawScene(lightingShader, cubeVAO, quadVAO, text1, text2);
+	drawScene(lightingShader, cubeVAO, quadVAO, cubeInstances, floorInstances, text1, text2);
 
 	// Debug
 	// debugShader.use();
@@ -237,7 +238,7 @@ uint32_t createVertexData(const float* vertices, const uint32_t n_verts, const u
 	glGenBuffers(1, &VBO);
 	glGenBuffers(1, &EBO);
 
-	glBindVertexArray(VAO);
+	GLState::instance().bindVertexArray(VAO);
 
 	// Bind buffers and assign data
 	glBindBuffer(GL_ARRAY_BUFFER, VBO);
@@ -260,7 +261,7 @@ uint32_t createVertexData(const float* vertices, const uint32_t n_verts, const u
 
 	// Unbind buffers and array
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::instance().bindVertexArray(0);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // NOTE: must happen after unbinding VAO
 
 	return VAO;
@@ -271,7 +272,7 @@ uint32_t createTexture(const char* path)
 	// Generate and bind texture
 	uint32_t texture;
 	glGenTextures(1, &texture);
-	glBindTexture(GL_TEXTURE_2D, texture);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, texture);
 
 	// Texture wrapping
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -403,9 +404,17 @@ int main(int argc, char* argv[])
 	uint32_t quadScreenVAO = createVertexData(quad_screen_vertices, (uint32_t) sizeof(quad_screen_vertices) / sizeof(float) / 8, quad_screen_indices, sizeof(quad_screen_indices) / sizeof(uint32_t));
 
 	// Create program and vertex data
-	const Shader lightingShader((projectDir + "/cube.vs").c_str(), (projectDir + "/cube.fs").c_str());
-	const Shader depthShader((projectDir + "/depth.vs").c_str(), (projectDir + "/depth.fs").c_str());
+	ShaderVariants lightingShaders((projectDir + "/cube.vs").c_str(), (projectDir + "/cube.fs").c_str());
+	ShaderDesc depthDesc = { projectDir + "/depth.vs", projectDir + "/depth.fs", "", { { k_InstancedDefine, "" } } };
+	const Shader depthShader(depthDesc);
 	const Shader debugShader((projectDir + "/debug.vs").c_str(), (projectDir + "/debug.fs").c_str());
+	FrameUniforms frame;
+
+	// Transforms of the floor and the cubes, read by the INSTANCED shader variants
+	InstanceBuffer cubeInstances(3), floorInstances(1);
+	cubeInstances.attach(cubeVAO);
+	floorInstances.attach(quadVAO);
+	createInstances(&cubeInstances, &floorInstances);
 
 	// Textures/maps
 	stbi_set_flip_vertically_on_load(true);
@@ -418,12 +427,12 @@ int main(int argc, char* argv[])
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); // NOTE: use GL_LINE to use "WIREFRAME MODE" instead
 
 	// Enable cull faces
-	glEnable(GL_CULL_FACE);
-	glCullFace(GL_BACK); // don't draw back faces
+	GLState::instance().setCullFace(true);
+	GLState::instance().cullFace(GL_BACK); // don't draw back faces
 
 	// Enable depth testing
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS);
+	GLState::instance().setDepthTest(true);
+	GLState::instance().depthFunc(GL_LESS);
 
 	while (!glfwWindowShouldClose(window))
 	{
@@ -435,7 +444,8 @@ int main(int argc, char* argv[])
 		handleInput(window, deltaTime);
 
 		// Render
-		render(cubeVAO, quadVAO, quadScreenVAO, lightingShader, depthShader, debugShader, text1, text2, fbo_res.first, fbo_res.second);
+		const Shader& lightingShader = lightingShaders.get({ { "PCF_RADIUS", std::to_string(pcf_radius) }, { k_InstancedDefine, "" } });
+		render(cubeVAO, quadVAO, quadScreenVAO, cubeInstances, floorInstances, lightingShader, depthShader, debugShader, text1, text2, fbo_res.first, fbo_res.second, frame);
 
 		// Swap front and back buffers
 		glfwSwapBuffers(window);
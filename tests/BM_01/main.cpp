@@ -0,0 +1,81 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include "model.h"
+#include "mesh_cache.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+std::string assetsDir = "../assets";
+
+const uint32_t k_Runs = 5;
+
+#pragma region Functions: for Benchmark
+
+double loadModelMs(const std::string& path)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	Model object(path);
+	glFinish(); // include the GL upload in the measurement
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(64, 64, "BM_01", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	const std::string path = (argc > 1) ? argv[1] : assetsDir + "/Freighter/Freigther_BI_Export.obj";
+	const std::string cachePath = MeshCache(path, 0).cachePath();
+
+	double cold = 0.0, warm = 0.0;
+	for (uint32_t i = 0; i < k_Runs; i++)
+	{
+		std::remove(cachePath.c_str()); // cold: Assimp import + cache write
+		cold += loadModelMs(path);
+		warm += loadModelMs(path); // warm: mapped cache only
+	}
+	cold /= k_Runs;
+	warm /= k_Runs;
+
+	std::cout << "Model: " << path << std::endl;
+	std::cout << "Cold load (Assimp + cache write): " << cold << " ms" << std::endl;
+	std::cout << "Warm load (mapped cache): " << warm << " ms" << std::endl;
+	std::cout << "Speedup: " << (warm > 0.0 ? cold / warm : 0.0) << "x" << std::endl;
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
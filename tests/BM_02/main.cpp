@@ -0,0 +1,76 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <iostream>
+#include "model.h"
+#include "texture_cache.h"
+#include "thread_pool.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+std::string assetsDir = "../assets";
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(64, 64, "BM_02", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	const std::string path = (argc > 1) ? argv[1] : assetsDir + "/Freighter/Freigther_BI_Export.obj";
+
+	{ // Models release their textures while the context is still alive
+		const auto start = std::chrono::high_resolution_clock::now();
+		Model object(path);
+		glFinish();
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		double totalDecode = 0.0, totalUpload = 0.0;
+		std::cout << "Texture" << "\t" << "Decode (ms)" << "\t" << "Upload (ms)" << std::endl;
+		for (const TextureTiming& timing : object.textureTimings_)
+		{
+			std::cout << timing.path << "\t" << timing.decodeMs << "\t" << timing.uploadMs << std::endl;
+			totalDecode += timing.decodeMs;
+			totalUpload += timing.uploadMs;
+		}
+
+		std::cout << "Textures: " << object.textureTimings_.size() << " on " << ThreadPool::shared().size() << " decode threads" << std::endl;
+		std::cout << "Sum of decode times: " << totalDecode << " ms" << std::endl;
+		std::cout << "Sum of upload times: " << totalUpload << " ms" << std::endl;
+		std::cout << "Model load wall time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+		// A second instance shares every texture through the global cache
+		Model shared(path);
+		const TextureCacheStats stats = TextureCache::instance().stats();
+		std::cout << "Texture cache: " << stats.hits << " hits, " << stats.misses << " misses, " <<
+			stats.residentTextures << " textures, " << stats.residentBytes / 1024 << " KiB resident" << std::endl;
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
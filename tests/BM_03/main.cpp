@@ -0,0 +1,168 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "shader.h"
+#include "model.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 800;
+uint32_t screen_height = 600;
+
+std::string projectDir = "../tests/BM_03";
+std::string assetsDir = "../assets";
+
+const uint32_t k_Frames = 200;
+const uint32_t k_SyntheticMeshes = 1000;
+
+struct FrameStats {
+	double submitMs;
+	double frameMs;
+};
+
+#pragma region Functions: for Benchmark
+
+// Grid of small cubes, one mesh each
+std::vector<MeshData> createSyntheticMeshes(const uint32_t count)
+{
+	const glm::vec3 normals[6] = {
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+		glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)
+	};
+	const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+
+	std::vector<MeshData> meshes(count);
+	for (uint32_t m = 0; m < count; m++)
+	{
+		const glm::vec3 center((m % side) * 1.5f - side * 0.75f, 0.0f, (m / side) * 1.5f - side * 0.75f);
+		for (uint32_t f = 0; f < 6; f++)
+		{
+			const glm::vec3 n = normals[f];
+			const glm::vec3 u = (std::abs(n.y) > 0.5f) ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+			const glm::vec3 v = glm::cross(n, u);
+			const uint32_t base = static_cast<uint32_t>(meshes[m].vertices.size());
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				const float su = (c == 1 || c == 2) ? 0.5f : -0.5f;
+				const float sv = (c >= 2) ? 0.5f : -0.5f;
+				Vertex vertex;
+				vertex.Position = center + n * 0.5f + u * su + v * sv;
+				vertex.Normal = n;
+				vertex.TexCoords = glm::vec2(su + 0.5f, sv + 0.5f);
+				vertex.Tangent = u;
+				vertex.Bitangent = v;
+				meshes[m].vertices.push_back(vertex);
+			}
+			const uint32_t quad[6] = { 0, 1, 2, 0, 2, 3 };
+			for (uint32_t i = 0; i < 6; i++)
+				meshes[m].indices.push_back(base + quad[i]);
+		}
+	}
+	return meshes;
+}
+
+FrameStats drawFrames(const Shader& shader, const Model& object, const float distance)
+{
+	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), (float)screen_width / screen_height, 0.1f, 500.0f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, distance * 0.5f, distance), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	FrameStats stats = { 0.0, 0.0 };
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		shader.use();
+		shader.set("projection", proj);
+		shader.set("view", view);
+		shader.set("model", glm::mat4(1.0f));
+		object.Draw(shader);
+
+		const auto submitted = std::chrono::high_resolution_clock::now();
+		glFinish();
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		stats.submitMs += std::chrono::duration<double, std::milli>(submitted - start).count();
+		stats.frameMs += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+	stats.submitMs /= k_Frames;
+	stats.frameMs /= k_Frames;
+	return stats;
+}
+
+void report(const char* name, const Model& perMesh, const Model& consolidated, const FrameStats& a, const FrameStats& b)
+{
+	std::cout << name << " (" << perMesh.meshes_.size() << " meshes)" << std::endl;
+	std::cout << "  Per-mesh:     " << a.submitMs << " ms submit, " << a.frameMs << " ms frame, " <<
+		perMesh.meshes_.size() << " VAO binds/frame" << std::endl;
+	std::cout << "  Consolidated: " << b.submitMs << " ms submit, " << b.frameMs << " ms frame, " <<
+		(consolidated.meshes_.empty() ? 0 : 1) << " VAO binds/frame" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_03", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_CULL_FACE);
+
+	{ // GL objects must go away before the context
+		const Shader shader((projectDir + "/model.vs").c_str(), (projectDir + "/model.fs").c_str());
+
+		ModelOptions perMeshOptions;
+		ModelOptions consolidatedOptions;
+		consolidatedOptions.storage = StorageMode::Consolidated;
+
+		const std::string path = assetsDir + "/Freighter/Freigther_BI_Export.obj";
+		const Model freighter(path, perMeshOptions);
+		const Model freighterConsolidated(path, consolidatedOptions);
+		const FrameStats a = drawFrames(shader, freighter, 60.0f);
+		const FrameStats b = drawFrames(shader, freighterConsolidated, 60.0f);
+		report("Freighter", freighter, freighterConsolidated, a, b);
+
+		const std::vector<MeshData> synthetic = createSyntheticMeshes(k_SyntheticMeshes);
+		const Model cubes(synthetic, perMeshOptions);
+		const Model cubesConsolidated(synthetic, consolidatedOptions);
+		const FrameStats c = drawFrames(shader, cubes, 80.0f);
+		const FrameStats d = drawFrames(shader, cubesConsolidated, 80.0f);
+		report("Synthetic", cubes, cubesConsolidated, c, d);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
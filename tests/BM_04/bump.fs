@@ -0,0 +1,23 @@
+#version 330 core
+
+in vec2 textCoords;
+
+in vec3 tangentLightPos;
+in vec3 tangentViewPos;
+in vec3 tangentFragPos;
+
+out vec4 fragColor;
+
+void main() {
+    vec3 color = vec3(0.6 + 0.4 * fract(textCoords.x * 8.0), 0.6, 0.6);
+    vec3 normal = vec3(0.0, 0.0, 1.0); // flat tangent-space normal
+
+    vec3 lightDir = normalize(tangentLightPos - tangentFragPos);
+    float diff = max(dot(normal, lightDir), 0.0);
+
+    vec3 viewDir = normalize(tangentViewPos - tangentFragPos);
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
+
+    fragColor = vec4(color * (0.1 + diff) + vec3(0.3 * spec), 1.0);
+}
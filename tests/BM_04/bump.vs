@@ -0,0 +1,36 @@
+#version 330 core
+layout (location=0) in vec3 aPos;
+layout (location=1) in vec3 aNormal;
+layout (location=2) in vec2 aTextCoords;
+layout (location=3) in vec3 aTangent;
+layout (location=4) in vec3 aBitangent;
+
+out vec2 textCoords;
+out vec3 tangentLightPos;
+out vec3 tangentViewPos;
+out vec3 tangentFragPos;
+
+uniform vec3 lightPos;
+uniform vec3 viewPos;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform mat3 normalMat;
+
+void main() {
+    vec3 fragPos = vec3(model * vec4(aPos, 1.0));
+    textCoords = aTextCoords;
+
+    vec3 T = normalize(normalMat * aTangent);
+    vec3 B = normalize(normalMat * aBitangent);
+    vec3 N = normalize(normalMat * aNormal);
+
+    mat3 TBN = transpose(mat3(T, B, N));
+
+    tangentLightPos = TBN * lightPos;
+    tangentViewPos = TBN * viewPos;
+    tangentFragPos = TBN * fragPos;
+
+    gl_Position = projection * view * vec4(fragPos, 1.0);
+}
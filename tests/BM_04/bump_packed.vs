@@ -0,0 +1,51 @@
+#version 330 core
+layout (location=0) in vec3 aPos; // float, or unorm16 inside the mesh bounds
+layout (location=1) in vec2 aNormal; // octahedral
+layout (location=2) in vec2 aTextCoords; // half floats
+layout (location=3) in ivec2 aTangent; // octahedral snorm16, lowest bit of y = bitangent sign
+
+out vec2 textCoords;
+out vec3 tangentLightPos;
+out vec3 tangentViewPos;
+out vec3 tangentFragPos;
+
+uniform vec3 lightPos;
+uniform vec3 viewPos;
+
+uniform vec3 positionScale;
+uniform vec3 positionBias;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform mat3 normalMat;
+
+vec3 octDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0) {
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(v);
+}
+
+void main() {
+    vec3 position = aPos * positionScale + positionBias;
+    vec3 normal = octDecode(aNormal);
+    vec3 tangent = octDecode(max(vec2(aTangent) / 32767.0, -1.0));
+    float bitangentSign = ((aTangent.y & 1) != 0) ? -1.0 : 1.0;
+
+    vec3 fragPos = vec3(model * vec4(position, 1.0));
+    textCoords = aTextCoords;
+
+    vec3 T = normalize(normalMat * tangent);
+    vec3 N = normalize(normalMat * normal);
+    vec3 B = bitangentSign * cross(N, T);
+
+    mat3 TBN = transpose(mat3(T, B, N));
+
+    tangentLightPos = TBN * lightPos;
+    tangentViewPos = TBN * viewPos;
+    tangentFragPos = TBN * fragPos;
+
+    gl_Position = projection * view * vec4(fragPos, 1.0);
+}
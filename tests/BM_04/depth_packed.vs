@@ -0,0 +1,12 @@
+#version 330 core
+layout (location = 0) in vec3 aPos; // float, or unorm16 inside the mesh bounds
+
+uniform vec3 positionScale;
+uniform vec3 positionBias;
+
+uniform mat4 model;
+uniform mat4 lightSpaceMatrix;
+
+void main() {
+    gl_Position = lightSpaceMatrix * model * vec4(aPos * positionScale + positionBias, 1.0);
+}
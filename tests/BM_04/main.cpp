@@ -0,0 +1,229 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "shader.h"
+#include "model.h"
+#include "gl_state.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_04";
+std::string assetsDir = "../assets";
+
+const uint32_t k_Frames = 100;
+const uint32_t k_Copies = 16; // draws of the dense mesh per pass
+const uint32_t k_Segments = 512; // sphere resolution, (k_Segments + 1)^2 vertices
+
+uint32_t shadow_width = 2048;
+uint32_t shadow_height = 2048;
+
+#pragma region Functions: for Benchmark
+
+// UV sphere with full tangent frames
+MeshData createSphere(const uint32_t segments)
+{
+	MeshData mesh;
+	const float pi = glm::pi<float>();
+	for (uint32_t y = 0; y <= segments; y++)
+	{
+		for (uint32_t x = 0; x <= segments; x++)
+		{
+			const float u = (float)x / segments;
+			const float v = (float)y / segments;
+			const float theta = u * 2.0f * pi;
+			const float phi = v * pi;
+
+			Vertex vertex;
+			vertex.Normal = glm::vec3(std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi));
+			vertex.Position = vertex.Normal;
+			vertex.TexCoords = glm::vec2(u, v);
+			vertex.Tangent = glm::normalize(glm::vec3(-std::sin(theta), 0.0f, std::cos(theta)));
+			vertex.Bitangent = glm::cross(vertex.Normal, vertex.Tangent);
+			mesh.vertices.push_back(vertex);
+		}
+	}
+	for (uint32_t y = 0; y < segments; y++)
+	{
+		for (uint32_t x = 0; x < segments; x++)
+		{
+			const uint32_t i0 = y * (segments + 1) + x;
+			const uint32_t i1 = i0 + segments + 1;
+			const uint32_t quad[6] = { i0, i1, i0 + 1, i0 + 1, i1, i1 + 1 };
+			mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+		}
+	}
+	return mesh;
+}
+
+uint32_t createShadowFBO(uint32_t* depthMap)
+{
+	uint32_t fbo;
+	GLState& state = GLState::instance();
+	glGenFramebuffers(1, &fbo);
+	state.bindFramebuffer(fbo);
+
+	glGenTextures(1, depthMap);
+	state.bindTexture(0, GL_TEXTURE_2D, *depthMap);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, shadow_width, shadow_height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, *depthMap, 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Error: FrameBuffer not complete." << std::endl;
+	}
+
+	state.bindFramebuffer(0);
+	return fbo;
+}
+
+glm::mat4 copyTransform(const uint32_t i)
+{
+	const float angle = (float)i / k_Copies * 2.0f * glm::pi<float>();
+	return glm::translate(glm::mat4(1.0f), glm::vec3(std::cos(angle) * 4.0f, 0.0f, std::sin(angle) * 4.0f));
+}
+
+double drawFrames(const Model& object, const Shader& lighting, const Shader& depth, const uint32_t fbo)
+{
+	const glm::vec3 lightPos(4.0f, 8.0f, 2.0f);
+	const glm::vec3 viewPos(0.0f, 6.0f, 12.0f);
+	const glm::mat4 lightSpaceMatrix = glm::ortho(-8.0f, 8.0f, -8.0f, 8.0f, 1.0f, 20.0f) *
+		glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), (float)screen_width / screen_height, 0.1f, 100.0f);
+	const glm::mat4 view = glm::lookAt(viewPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	GLState& state = GLState::instance();
+	double total = 0.0;
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+
+		// Shadow pass: positions only
+		state.bindFramebuffer(fbo);
+		glViewport(0, 0, shadow_width, shadow_height);
+		glClear(GL_DEPTH_BUFFER_BIT);
+		depth.use();
+		depth.set("lightSpaceMatrix", lightSpaceMatrix);
+		for (uint32_t i = 0; i < k_Copies; i++)
+		{
+			depth.set("model", copyTransform(i));
+			object.Draw(depth);
+		}
+
+		// Main pass: every attribute
+		state.bindFramebuffer(0);
+		glViewport(0, 0, screen_width, screen_height);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		lighting.use();
+		lighting.set("projection", proj);
+		lighting.set("view", view);
+		lighting.set("viewPos", viewPos);
+		lighting.set("lightPos", lightPos);
+		for (uint32_t i = 0; i < k_Copies; i++)
+		{
+			const glm::mat4 model = copyTransform(i);
+			lighting.set("model", model);
+			lighting.set("normalMat", glm::mat3(glm::transpose(glm::inverse(model))));
+			object.Draw(lighting);
+		}
+
+		glFinish();
+		const auto end = std::chrono::high_resolution_clock::now();
+		total += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+	return total / k_Frames;
+}
+
+size_t vertexBytes(const Model& object, const VertexFormat format)
+{
+	size_t bytes = 0;
+	for (const Mesh& mesh : object.meshes_)
+		bytes += mesh.vertices_.size() * vertexStride(format);
+	return bytes;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_04", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	GLState::instance().setDepthTest(true);
+	GLState::instance().setCullFace(true);
+
+	{ // GL objects must go away before the context
+		const Shader lighting((projectDir + "/bump.vs").c_str(), (projectDir + "/bump.fs").c_str());
+		const Shader lightingPacked((projectDir + "/bump_packed.vs").c_str(), (projectDir + "/bump.fs").c_str());
+		const Shader depth((projectDir + "/depth.vs").c_str(), (projectDir + "/depth.fs").c_str());
+		const Shader depthPacked((projectDir + "/depth_packed.vs").c_str(), (projectDir + "/depth.fs").c_str());
+
+		uint32_t depthMap;
+		const uint32_t fbo = createShadowFBO(&depthMap);
+
+		const std::vector<MeshData> sphere(1, createSphere(k_Segments));
+		const std::string freighterPath = assetsDir + "/Freighter/Freigther_BI_Export.obj";
+
+		const VertexFormat formats[3] = { VertexFormat::Full, VertexFormat::Packed, VertexFormat::PackedQuantized };
+		const char* names[3] = { "Full", "Packed", "PackedQuantized" };
+		for (uint32_t f = 0; f < 3; f++)
+		{
+			ModelOptions options;
+			options.vertexFormat = formats[f];
+			const bool packed = formats[f] != VertexFormat::Full;
+
+			const Model dense(sphere, options);
+			const Model freighter(freighterPath, options);
+			const double frameMs = drawFrames(dense, packed ? lightingPacked : lighting, packed ? depthPacked : depth, fbo);
+
+			std::cout << names[f] << " (" << vertexStride(formats[f]) << " bytes/vertex)" << std::endl;
+			std::cout << "  Sphere vertex buffer:    " << vertexBytes(dense, formats[f]) / 1024 << " KiB" << std::endl;
+			std::cout << "  Freighter vertex buffer: " << vertexBytes(freighter, formats[f]) / 1024 << " KiB" << std::endl;
+			std::cout << "  Frame time (shadow + main pass, " << k_Copies << " spheres): " << frameMs << " ms" << std::endl;
+		}
+
+		glDeleteFramebuffers(1, &fbo);
+		glDeleteTextures(1, &depthMap);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,179 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include "shader.h"
+#include "model.h"
+#include "mesh_cache.h"
+#include "mesh_optimizer.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_05";
+std::string assetsDir = "../assets";
+
+const uint32_t k_Frames = 200;
+const uint32_t k_Segments = 400; // sphere resolution
+
+#pragma region Functions: for Benchmark
+
+// Sphere exported the worst way: one vertex per corner, triangles in random order
+MeshData createTriangleSoup(const uint32_t segments)
+{
+	std::vector<Vertex> grid;
+	const float pi = glm::pi<float>();
+	for (uint32_t y = 0; y <= segments; y++)
+	{
+		for (uint32_t x = 0; x <= segments; x++)
+		{
+			const float theta = (float)x / segments * 2.0f * pi;
+			const float phi = (float)y / segments * pi;
+			Vertex vertex;
+			vertex.Position = glm::vec3(std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi));
+			vertex.Normal = vertex.Position;
+			vertex.TexCoords = glm::vec2((float)x / segments, (float)y / segments);
+			vertex.Tangent = glm::vec3(-std::sin(theta), 0.0f, std::cos(theta));
+			vertex.Bitangent = glm::cross(vertex.Normal, vertex.Tangent);
+			grid.push_back(vertex);
+		}
+	}
+
+	std::vector<glm::uvec3> triangles;
+	for (uint32_t y = 0; y < segments; y++)
+	{
+		for (uint32_t x = 0; x < segments; x++)
+		{
+			const uint32_t i0 = y * (segments + 1) + x;
+			const uint32_t i1 = i0 + segments + 1;
+			triangles.push_back(glm::uvec3(i0, i1, i0 + 1));
+			triangles.push_back(glm::uvec3(i0 + 1, i1, i1 + 1));
+		}
+	}
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+
+	MeshData mesh;
+	for (const glm::uvec3& triangle : triangles)
+	{
+		for (uint32_t k = 0; k < 3; k++)
+		{
+			mesh.indices.push_back((uint32_t)mesh.vertices.size());
+			mesh.vertices.push_back(grid[triangle[k]]);
+		}
+	}
+	return mesh;
+}
+
+double drawFrames(const Shader& shader, const Model& object)
+{
+	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), (float)screen_width / screen_height, 0.1f, 100.0f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	shader.use();
+	shader.set("projection", proj);
+	shader.set("view", view);
+	shader.set("model", glm::mat4(1.0f));
+
+	double total = 0.0;
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		object.Draw(shader);
+		glFinish();
+		const auto end = std::chrono::high_resolution_clock::now();
+		total += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+	return total / k_Frames;
+}
+
+void printStats(const std::string& name, const std::vector<MeshOptimizationStats>& stats)
+{
+	std::cout << name << std::endl;
+	std::cout << "  mesh   vertices (before -> after)  triangles  index  ACMR (before -> after)  ATVR (before -> after)" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+	for (size_t i = 0; i < stats.size(); i++)
+	{
+		const MeshOptimizationStats& mesh = stats[i];
+		std::cout << "  " << std::setw(4) << i
+			<< "   " << std::setw(8) << mesh.verticesBefore << " -> " << std::setw(8) << mesh.verticesAfter
+			<< "         " << std::setw(8) << mesh.numTriangles
+			<< "  " << std::setw(3) << mesh.indexSize * 8 << "b"
+			<< "   " << mesh.before.acmr << " -> " << mesh.after.acmr
+			<< "          " << mesh.before.atvr << " -> " << mesh.after.atvr << std::endl;
+	}
+	std::cout << std::defaultfloat;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_05", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	glEnable(GL_DEPTH_TEST);
+
+	{ // GL objects must go away before the context
+		// Imported model: the optimization runs on import, so drop the cache first
+		const std::string path = (argc > 1) ? argv[1] : assetsDir + "/Freighter/Freigther_BI_Export.obj";
+		std::remove(MeshCache(path, 0).cachePath().c_str());
+		const Model freighter(path);
+		printStats(path, freighter.optimizationStats_);
+
+		// Synthetic worst case, drawn before and after optimization
+		const std::vector<MeshData> raw(1, createTriangleSoup(k_Segments));
+		std::vector<MeshData> optimized = raw;
+		std::vector<MeshOptimizationStats> stats(1);
+		optimizeMesh(optimized[0], &stats[0]);
+		printStats("Shuffled triangle soup sphere", stats);
+
+		const Shader shader((projectDir + "/model.vs").c_str(), (projectDir + "/model.fs").c_str());
+		const Model rawModel(raw);
+		const Model optimizedModel(optimized);
+		const double rawMs = drawFrames(shader, rawModel);
+		const double optimizedMs = drawFrames(shader, optimizedModel);
+		std::cout << "Frame time, soup as exported: " << rawMs << " ms" << std::endl;
+		std::cout << "Frame time, optimized:        " << optimizedMs << " ms" << std::endl;
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+#version 330 core
+
+in vec3 normal;
+
+out vec4 fragColor;
+
+void main() {
+    vec3 lightDir = normalize(vec3(0.3, 1.0, 0.5));
+    float diff = max(dot(normalize(normal), lightDir), 0.0);
+    fragColor = vec4(vec3(0.1 + 0.9 * diff), 1.0);
+}
@@ -0,0 +1,152 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "shader.h"
+#include "camera.h"
+#include "model.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_06";
+std::string assetsDir = "../assets";
+
+const uint32_t k_Frames = 100;
+const float k_Spacing = 40.0f; // distance between instances
+
+struct FrameStats {
+	double frameMs;
+	uint64_t triangles; // per frame
+};
+
+#pragma region Functions: for Benchmark
+
+// Instances on a square grid stretching away from the camera
+std::vector<glm::mat4> createInstances(const uint32_t count)
+{
+	const uint32_t side = (uint32_t)std::ceil(std::sqrt((float)count));
+	std::vector<glm::mat4> instances;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const float x = ((float)(i % side) - side * 0.5f) * k_Spacing;
+		const float z = -(float)(i / side) * k_Spacing;
+		instances.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, z)));
+	}
+	return instances;
+}
+
+FrameStats drawFrames(const Shader& shader, const Model& object, const Camera& camera,
+	const std::vector<glm::mat4>& instances, const bool useLods)
+{
+	const glm::mat4 proj = glm::perspective(glm::radians(camera.getFOV()), (float)screen_width / screen_height, 0.1f, 5000.0f);
+
+	LodSettings settings;
+	settings.viewportHeight = (float)screen_height;
+	std::vector<LodState> states(instances.size());
+
+	FrameStats stats = { 0.0, 0 };
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		shader.use();
+		shader.set("projection", proj);
+		shader.set("view", camera.getViewMatrix());
+		for (uint32_t i = 0; i < instances.size(); i++)
+		{
+			if (useLods)
+				object.Draw(shader, camera, instances[i], settings, &states[i]);
+			else
+				object.Draw(shader, instances[i]);
+		}
+
+		glFinish();
+		const auto end = std::chrono::high_resolution_clock::now();
+		stats.frameMs += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+	stats.frameMs /= k_Frames;
+
+	for (uint32_t i = 0; i < instances.size(); i++)
+	{
+		for (uint32_t m = 0; m < object.meshes_.size(); m++)
+		{
+			const uint32_t lod = useLods ? states[i].levels[m] : 0;
+			stats.triangles += object.meshes_[m].lods_[lod].numIndices / 3;
+		}
+	}
+	return stats;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_06", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	glEnable(GL_DEPTH_TEST);
+
+	{ // GL objects must go away before the context
+		const Shader shader((projectDir + "/model.vs").c_str(), (projectDir + "/model.fs").c_str());
+		const Model freighter(assetsDir + "/Freighter/Freigther_BI_Export.obj");
+		const Camera camera(glm::vec3(0.0f, 15.0f, 60.0f));
+
+		std::cout << "Freighter LOD chain:" << std::endl;
+		for (uint32_t m = 0; m < freighter.meshes_.size(); m++)
+		{
+			std::cout << "  mesh " << m << ":";
+			for (const MeshLod& lod : freighter.meshes_[m].lods_)
+				std::cout << " " << lod.numIndices / 3 << " tris (error " << lod.error << ")";
+			std::cout << std::endl;
+		}
+
+		const uint32_t counts[4] = { 1, 10, 100, 1000 };
+		for (const uint32_t count : counts)
+		{
+			const std::vector<glm::mat4> instances = createInstances(count);
+			const FrameStats full = drawFrames(shader, freighter, camera, instances, false);
+			const FrameStats lod = drawFrames(shader, freighter, camera, instances, true);
+			std::cout << count << " instances" << std::endl;
+			std::cout << "  Full resolution: " << full.frameMs << " ms, " << full.triangles << " triangles" << std::endl;
+			std::cout << "  LOD selection:   " << lod.frameMs << " ms, " << lod.triangles << " triangles" << std::endl;
+		}
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
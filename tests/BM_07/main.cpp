@@ -0,0 +1,84 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <iostream>
+#include "model.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+std::string assetsDir = "../assets";
+
+#pragma region Functions: for Benchmark
+
+void report(const char* name, const Model& object, const double loadMs)
+{
+	std::cout << "  " << name << ": " << object.cpuBytes() / 1024 << " KiB CPU geometry";
+	if (loadMs >= 0.0) std::cout << ", loaded in " << loadMs << " ms";
+	std::cout << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(64, 64, "BM_07", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	{ // GL objects must go away before the context
+		const std::string path = (argc > 1) ? argv[1] : assetsDir + "/Freighter/Freigther_BI_Export.obj";
+		{ Model warmup(path); } // make sure the mesh cache exists
+
+		std::cout << "Model: " << path << std::endl;
+		const CpuGeometry policies[3] = { CpuGeometry::Keep, CpuGeometry::Collision, CpuGeometry::Discard };
+		const char* names[3] = { "Keep", "Collision", "Discard" };
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			ModelOptions options;
+			options.cpuGeometry = policies[i];
+			const auto start = std::chrono::high_resolution_clock::now();
+			Model object(path, options);
+			glFinish();
+			const auto end = std::chrono::high_resolution_clock::now();
+			report(names[i], object, std::chrono::duration<double, std::milli>(end - start).count());
+		}
+
+		// Policy applied after the fact
+		Model object(path);
+		std::cout << "Release after load:" << std::endl;
+		report("Before", object, -1.0);
+		object.releaseCpuGeometry(CpuGeometry::Collision);
+		report("After Collision", object, -1.0);
+		object.releaseCpuGeometry(CpuGeometry::Discard);
+		report("After Discard", object, -1.0);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "model.h"
+#include "mesh_cache.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+std::string assetsDir = "../assets";
+
+#pragma region Functions: for Benchmark
+
+// Loads the model in its own scope, so its textures leave the TextureCache again
+ModelLoadStats loadStats(const std::string& path)
+{
+	const Model object(path);
+	return object.loadStats_;
+}
+
+void dump(const char* name, const ModelLoadStats& stats, const std::string& file)
+{
+	const std::string json = stats.toJson();
+	std::cout << name << ":" << std::endl << json;
+
+	std::ofstream out(file);
+	out << json;
+	std::cout << "Written to " << file << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(64, 64, "BM_08", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	const std::string path = (argc > 1) ? argv[1] : assetsDir + "/Freighter/Freigther_BI_Export.obj";
+	std::remove(MeshCache(path, 0).cachePath().c_str());
+
+	std::cout << "Model: " << path << std::endl;
+	dump("Cold load (Assimp import)", loadStats(path), "load_cold.json");
+	dump("Warm load (mesh cache)", loadStats(path), "load_warm.json");
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,186 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <chrono>
+#include <iostream>
+#include "shader.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_09";
+
+const uint32_t k_Frames = 200;
+const uint32_t k_Objects = 1000;
+
+enum class Path {
+	Lookup, // glGetUniformLocation before every upload, as Shader::set used to
+	Names, // Shader::set with names
+	Handles // Shader::set with handles resolved once
+};
+
+#pragma region Functions: for Benchmark
+
+uint32_t createCube()
+{
+	std::vector<float> vertices;
+	for (uint32_t face = 0; face < 6; face++)
+	{
+		const glm::vec3 normal = glm::vec3(face % 3 == 0, face % 3 == 1, face % 3 == 2) * (face < 3 ? 1.0f : -1.0f);
+		const glm::vec3 u = glm::vec3(normal.y, normal.z, normal.x);
+		const glm::vec3 v = glm::cross(normal, u);
+		const float corners[6][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, -1 }, { 1, 1 }, { -1, 1 } };
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			const glm::vec3 p = (normal + u * corners[i][0] + v * corners[i][1]) * 0.5f;
+			const float vertex[8] = { p.x, p.y, p.z, normal.x, normal.y, normal.z, corners[i][0] * 0.5f + 0.5f, corners[i][1] * 0.5f + 0.5f };
+			vertices.insert(vertices.end(), vertex, vertex + 8);
+		}
+	}
+
+	uint32_t VAO, VBO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+	glEnableVertexAttribArray(2);
+	glBindVertexArray(0);
+	return VAO;
+}
+
+// Sets the uniforms AG_08_05 uses for every object, most of them the same each time
+double drawFrames(const Shader& shader, const uint32_t VAO, const Path path)
+{
+	const char* vec3Names[13] = {
+		"viewPos", "dirLight.direction", "dirLight.ambient", "dirLight.diffuse", "dirLight.specular",
+		"pointLights[0].position", "pointLights[0].ambient", "pointLights[0].diffuse", "pointLights[0].specular",
+		"pointLights[1].position", "pointLights[1].ambient", "pointLights[1].diffuse", "pointLights[1].specular"
+	};
+	const char* floatNames[7] = {
+		"pointLights[0].constant", "pointLights[0].linear", "pointLights[0].quadratic",
+		"pointLights[1].constant", "pointLights[1].linear", "pointLights[1].quadratic", "material.shininess"
+	};
+	UniformHandle vec3Handles[13], floatHandles[7];
+	for (uint32_t i = 0; i < 13; i++) vec3Handles[i] = shader.uniform(vec3Names[i]);
+	for (uint32_t i = 0; i < 7; i++) floatHandles[i] = shader.uniform(floatNames[i]);
+	const UniformHandle model = shader.uniform("model"), normalMat = shader.uniform("normalMat");
+
+	int32_t program = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+
+	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), (float)screen_width / screen_height, 0.1f, 200.0f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 20.0f, 60.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	shader.set("projection", proj);
+	shader.set("view", view);
+
+	glBindVertexArray(VAO);
+	double total = 0.0;
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		for (uint32_t i = 0; i < k_Objects; i++)
+		{
+			const glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3((float)(i % 40) - 20.0f, 0.0f, -(float)(i / 40) * 2.0f));
+			const glm::mat3 normal = glm::mat3(glm::transpose(glm::inverse(transform)));
+			const glm::vec3 value = glm::vec3(0.5f); // scene constants, the same every object
+			if (path == Path::Lookup)
+			{
+				for (uint32_t u = 0; u < 13; u++) glUniform3fv(glGetUniformLocation(program, vec3Names[u]), 1, glm::value_ptr(value));
+				for (uint32_t u = 0; u < 7; u++) glUniform1f(glGetUniformLocation(program, floatNames[u]), 1.0f);
+				glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, glm::value_ptr(transform));
+				glUniformMatrix3fv(glGetUniformLocation(program, "normalMat"), 1, GL_FALSE, glm::value_ptr(normal));
+			}
+			else if (path == Path::Names)
+			{
+				for (uint32_t u = 0; u < 13; u++) shader.set(vec3Names[u], value);
+				for (uint32_t u = 0; u < 7; u++) shader.set(floatNames[u], 1.0f);
+				shader.set("model", transform);
+				shader.set("normalMat", normal);
+			}
+			else
+			{
+				for (uint32_t u = 0; u < 13; u++) shader.set(vec3Handles[u], value);
+				for (uint32_t u = 0; u < 7; u++) shader.set(floatHandles[u], 1.0f);
+				shader.set(model, transform);
+				shader.set(normalMat, normal);
+			}
+			glDrawArrays(GL_TRIANGLES, 0, 36);
+		}
+		glFinish();
+		const auto end = std::chrono::high_resolution_clock::now();
+		total += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+	glBindVertexArray(0);
+	return total / k_Frames;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_09", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	glEnable(GL_DEPTH_TEST);
+
+	{ // GL objects must go away before the context
+		const Shader shader((projectDir + "/cube.vs").c_str(), (projectDir + "/cube.fs").c_str());
+		shader.use();
+		const uint32_t VAO = createCube();
+
+		const Path paths[3] = { Path::Lookup, Path::Names, Path::Handles };
+		const char* names[3] = { "glGetUniformLocation per upload", "Shader::set by name", "Shader::set by handle" };
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			Shader::resetUniformStats();
+			const double frameMs = drawFrames(shader, VAO, paths[i]);
+			const UniformStats& stats = Shader::uniformStats();
+			std::cout << names[i] << ": " << frameMs << " ms per frame (" << k_Objects << " objects, 22 uniforms each)" << std::endl;
+			if (paths[i] != Path::Lookup)
+				std::cout << "  uploads per frame: " << stats.issued / k_Frames << " issued, " << stats.skipped / k_Frames << " skipped" << std::endl;
+		}
+		glDeleteVertexArrays(1, &VAO);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
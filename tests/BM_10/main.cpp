@@ -0,0 +1,183 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include "shader.h"
+#include "frame_uniforms.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_10";
+
+const uint32_t k_Frames = 200;
+const uint32_t k_DrawsPerProgram = 16;
+
+struct FrameStats {
+	double frameMs;
+	double uniformUploads; // glUniform* calls per frame
+	double bufferUploads; // uniform buffer updates per frame
+};
+
+#pragma region Functions: for Benchmark
+
+uint32_t createCube()
+{
+	std::vector<float> vertices;
+	for (uint32_t face = 0; face < 6; face++)
+	{
+		const glm::vec3 normal = glm::vec3(face % 3 == 0, face % 3 == 1, face % 3 == 2) * (face < 3 ? 1.0f : -1.0f);
+		const glm::vec3 u = glm::vec3(normal.y, normal.z, normal.x);
+		const glm::vec3 v = glm::cross(normal, u);
+		const float corners[6][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, -1 }, { 1, 1 }, { -1, 1 } };
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			const glm::vec3 p = (normal + u * corners[i][0] + v * corners[i][1]) * 0.5f;
+			const float vertex[6] = { p.x, p.y, p.z, normal.x, normal.y, normal.z };
+			vertices.insert(vertices.end(), vertex, vertex + 6);
+		}
+	}
+
+	uint32_t VAO, VBO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
+	return VAO;
+}
+
+// Every program draws a few cubes, the camera moves every frame so nothing can be skipped
+FrameStats drawFrames(const std::vector<std::unique_ptr<Shader>>& programs, const uint32_t VAO, FrameUniforms* frame)
+{
+	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), (float)screen_width / screen_height, 0.1f, 200.0f);
+	const glm::vec3 lightPos(-2.0f, 10.0f, -1.0f);
+	const glm::mat4 lightSpaceMatrix = glm::ortho(-20.0f, 20.0f, -20.0f, 20.0f, 1.0f, 30.0f) *
+		glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	Shader::resetUniformStats();
+	FrameStats stats = { 0.0, 0.0, 0.0 };
+	glBindVertexArray(VAO);
+	for (uint32_t f = 0; f < k_Frames; f++)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		const glm::vec3 viewPos(std::sin(f * 0.01f) * 30.0f, 10.0f, std::cos(f * 0.01f) * 30.0f);
+		const glm::mat4 view = glm::lookAt(viewPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		if (frame)
+		{
+			frame->setCamera(proj, view, viewPos);
+			frame->setLight(lightPos, lightSpaceMatrix);
+			frame->upload();
+			stats.bufferUploads++;
+		}
+
+		for (uint32_t p = 0; p < programs.size(); p++)
+		{
+			const Shader& shader = *programs[p];
+			shader.use();
+			if (!frame)
+			{
+				shader.set("projection", proj);
+				shader.set("view", view);
+				shader.set("lightSpaceMatrix", lightSpaceMatrix);
+				shader.set("viewPos", viewPos);
+				shader.set("lightPos", lightPos);
+			}
+			for (uint32_t i = 0; i < k_DrawsPerProgram; i++)
+			{
+				const float x = (float)(p % 8) * 2.5f - 10.0f;
+				const float z = (float)(p / 8) * 2.5f - 10.0f;
+				shader.set("model", glm::translate(glm::mat4(1.0f), glm::vec3(x, (float)i * 1.5f, z)));
+				glDrawArrays(GL_TRIANGLES, 0, 36);
+			}
+		}
+
+		glFinish();
+		const auto end = std::chrono::high_resolution_clock::now();
+		stats.frameMs += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+	glBindVertexArray(0);
+
+	stats.frameMs /= k_Frames;
+	stats.uniformUploads = (double)Shader::uniformStats().issued / k_Frames;
+	stats.bufferUploads /= k_Frames;
+	return stats;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_10", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	glEnable(GL_DEPTH_TEST);
+
+	{ // GL objects must go away before the context
+		const uint32_t VAO = createCube();
+		FrameUniforms frame;
+
+		const uint32_t counts[5] = { 1, 4, 16, 32, 64 };
+		for (const uint32_t count : counts)
+		{
+			// Separate programs, as a scene with that many materials would have
+			std::vector<std::unique_ptr<Shader>> uniformPrograms, blockPrograms;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uniformPrograms.emplace_back(new Shader((projectDir + "/uniforms.vs").c_str(), (projectDir + "/uniforms.fs").c_str()));
+				blockPrograms.emplace_back(new Shader((projectDir + "/block.vs").c_str(), (projectDir + "/block.fs").c_str()));
+			}
+
+			const FrameStats uniforms = drawFrames(uniformPrograms, VAO, nullptr);
+			const FrameStats block = drawFrames(blockPrograms, VAO, &frame);
+			std::cout << count << " programs" << std::endl;
+			std::cout << "  Per-program uniforms: " << uniforms.frameMs << " ms, " << uniforms.uniformUploads << " glUniform calls per frame" << std::endl;
+			std::cout << "  Frame block:          " << block.frameMs << " ms, " << block.uniformUploads << " glUniform calls + "
+				<< block.bufferUploads << " buffer update per frame" << std::endl;
+		}
+		glDeleteVertexArrays(1, &VAO);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,18 @@
+#version 330 core
+
+in vec3 normal;
+in vec3 fragPos;
+in vec4 fragPosLightSpace;
+
+uniform vec3 viewPos;
+uniform vec3 lightPos;
+
+out vec4 fragColor;
+
+void main() {
+    vec3 n = normalize(normal);
+    vec3 lightDir = normalize(lightPos - fragPos);
+    vec3 halfway = normalize(lightDir + normalize(viewPos - fragPos));
+    float light = 0.1 + max(dot(n, lightDir), 0.0) + pow(max(dot(n, halfway), 0.0), 32.0);
+    fragColor = vec4(vec3(light) * (0.5 + 0.5 * fragPosLightSpace.z), 1.0);
+}
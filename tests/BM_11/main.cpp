@@ -0,0 +1,112 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include "shader.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string testsDir = "../tests";
+
+// Every program of the test apps, as compiled by their startup
+const char* k_Programs[][2] = {
+	{ "AG_03/vertex.vs", "AG_03/fragment.fs" },
+	{ "AG_06/cube.vs", "AG_06/cube.fs" },
+	{ "AG_06/light.vs", "AG_06/light.fs" },
+	{ "AG_08_04/cube.vs", "AG_08_04/cube.fs" },
+	{ "AG_08_04/light.vs", "AG_08_04/light.fs" },
+	{ "AG_08_05/cube.vs", "AG_08_05/cube.fs" },
+	{ "AG_09/shader.vs", "AG_09/shader.fs" },
+	{ "AG_10_02/stencil.vs", "AG_10_02/stencil.fs" },
+	{ "AG_10_03/blending.vs", "AG_10_03/blending.fs" },
+	{ "AG_11_02/bump.vs", "AG_11_02/bump.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_blur.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_border_detection.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_sharpen.fs" },
+	{ "AG_13/cube.vs", "AG_13/cube.fs" },
+	{ "AG_13/depth.vs", "AG_13/depth.fs" },
+	{ "AG_13/debug.vs", "AG_13/debug.fs" },
+	{ "BM_04/bump_packed.vs", "BM_04/bump.fs" },
+	{ "BM_05/model.vs", "BM_05/model.fs" },
+	{ "BM_10/block.vs", "BM_10/block.fs" }
+};
+
+#pragma region Functions: for Benchmark
+
+// Creates every program like an app startup would, returns the time until all are usable
+double startup(const char* label)
+{
+	Shader::resetProgramCacheStats();
+	const auto start = std::chrono::high_resolution_clock::now();
+	{
+		std::vector<std::unique_ptr<Shader>> programs;
+		for (const auto& program : k_Programs)
+		{
+			programs.emplace_back(new Shader((testsDir + "/" + program[0]).c_str(), (testsDir + "/" + program[1]).c_str()));
+		}
+		glFinish();
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+	const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+	const ProgramCacheStats& stats = Shader::programCacheStats();
+	std::cout << label << ": " << ms << " ms for " << sizeof(k_Programs) / sizeof(k_Programs[0]) << " programs" << std::endl;
+	std::cout << "  cache hits " << stats.hits << ", misses " << stats.misses << ", rejected " << stats.rejected << std::endl;
+	std::cout << "  from binary " << stats.loadMs << " ms, from source " << stats.compileMs << " ms" << std::endl;
+	return ms;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_11", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	// Cold: no binaries, every program is compiled and linked from source
+	const std::string cacheDir = Shader::programCacheDir();
+	Shader::setProgramCacheDir("");
+	const double cold = startup("Cold (cache disabled)");
+
+	// Fills the cache on the first run of the benchmark, later runs already hit it
+	Shader::setProgramCacheDir(cacheDir);
+	startup("Cache enabled");
+
+	// Warm: every program comes from its cached binary
+	const double warm = startup("Warm");
+	std::cout << "Warm startup is " << cold / warm << "x faster" << std::endl;
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include "gl_extensions.h"
+#include "model.h"
+#include "shader.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string testsDir = "../tests";
+std::string assetsDir = "../assets";
+
+const char* k_Programs[][2] = {
+	{ "AG_03/vertex.vs", "AG_03/fragment.fs" },
+	{ "AG_06/cube.vs", "AG_06/cube.fs" },
+	{ "AG_06/light.vs", "AG_06/light.fs" },
+	{ "AG_08_04/cube.vs", "AG_08_04/cube.fs" },
+	{ "AG_08_04/light.vs", "AG_08_04/light.fs" },
+	{ "AG_08_05/cube.vs", "AG_08_05/cube.fs" },
+	{ "AG_09/shader.vs", "AG_09/shader.fs" },
+	{ "AG_10_02/stencil.vs", "AG_10_02/stencil.fs" },
+	{ "AG_10_03/blending.vs", "AG_10_03/blending.fs" },
+	{ "AG_11_02/bump.vs", "AG_11_02/bump.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_blur.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_border_detection.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_sharpen.fs" },
+	{ "AG_13/cube.vs", "AG_13/cube.fs" },
+	{ "AG_13/depth.vs", "AG_13/depth.fs" },
+	{ "AG_13/debug.vs", "AG_13/debug.fs" },
+	{ "BM_04/bump_packed.vs", "BM_04/bump.fs" },
+	{ "BM_05/model.vs", "BM_05/model.fs" },
+	{ "BM_10/block.vs", "BM_10/block.fs" }
+};
+
+typedef std::chrono::high_resolution_clock Clock;
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<ShaderDesc> programDescs()
+{
+	std::vector<ShaderDesc> descs;
+	for (const auto& program : k_Programs)
+	{
+		ShaderDesc desc;
+		desc.vertexPath = testsDir + "/" + program[0];
+		desc.fragmentPath = testsDir + "/" + program[1];
+		descs.push_back(desc);
+	}
+	return descs;
+}
+
+// Compiles every program before loading the model, the way the test apps start
+void blockingStartup(const std::string& modelPath)
+{
+	const auto start = Clock::now();
+	std::vector<std::unique_ptr<Shader>> programs;
+	for (const ShaderDesc& desc : programDescs())
+	{
+		programs.emplace_back(new Shader(desc.vertexPath.c_str(), desc.fragmentPath.c_str()));
+	}
+	const double shadersMs = elapsedMs(start);
+
+	const auto loadStart = Clock::now();
+	const Model model(modelPath);
+	const double modelMs = elapsedMs(loadStart);
+
+	for (const auto& program : programs) program->use();
+	glFinish();
+	std::cout << "Blocking: shaders " << shadersMs << " ms, model " << modelMs << " ms, total " << elapsedMs(start) << " ms" << std::endl;
+}
+
+// Submits every program, loads the model while the driver compiles and waits at first use
+void batchStartup(const std::string& modelPath)
+{
+	const auto start = Clock::now();
+	const std::vector<std::unique_ptr<Shader>> programs = Shader::compileBatch(programDescs());
+	const double submitMs = elapsedMs(start);
+
+	const auto loadStart = Clock::now();
+	const Model model(modelPath);
+	const double modelMs = elapsedMs(loadStart);
+
+	// Only polls with KHR_parallel_shader_compile, ready() waits for the program otherwise
+	uint32_t ready = 0;
+	if (glExtensions().parallelShaderCompile)
+	{
+		for (const auto& program : programs) ready += program->ready() ? 1 : 0;
+	}
+
+	const auto useStart = Clock::now();
+	for (const auto& program : programs) program->use();
+	glFinish();
+	const double waitMs = elapsedMs(useStart);
+	std::cout << "Batch: submit " << submitMs << " ms, model " << modelMs << " ms, waiting at first use " << waitMs
+		<< " ms, total " << elapsedMs(start) << " ms (" << ready << "/" << programs.size() << " ready after the model load)" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_12", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	const std::string modelPath = (argc > 1) ? argv[1] : assetsDir + "/Freighter/Freigther_BI_Export.obj";
+	std::cout << "KHR_parallel_shader_compile: " << (glExtensions().parallelShaderCompile ? "yes" : "no") << std::endl;
+
+	// Binaries would hide the compile, and the first load writes the mesh cache both runs then read
+	Shader::setProgramCacheDir("");
+	{
+		const Model warmup(modelPath);
+	}
+
+	blockingStartup(modelPath);
+	batchStartup(modelPath);
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+
+uniform mat4 viewProj;
+
+out vec3 fragPos;
+
+void main() {
+    fragPos = vec3(aPos.x, 0.0, aPos.y) * 20.0;
+    gl_Position = viewProj * vec4(fragPos, 1.0);
+}
@@ -0,0 +1,84 @@
+#version 330 core
+
+in vec3 fragPos;
+
+out vec4 fragColor;
+
+struct DirLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+struct PointLight {
+    vec3 position;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+layout (std140) uniform Lights {
+    DirLight dirLight;
+    int numPointLights;
+#ifndef POINT_LIGHTS_TEXTURE_BUFFER
+    PointLight pointLights[MAX_POINT_LIGHTS];
+#endif
+};
+
+#ifdef POINT_LIGHTS_TEXTURE_BUFFER
+uniform samplerBuffer pointLightTexels;
+
+// 5 RGBA32F texels per light, laid out like the std140 struct
+PointLight fetchPointLight(int i) {
+    vec4 t0 = texelFetch(pointLightTexels, i * 5 + 0);
+    vec4 t1 = texelFetch(pointLightTexels, i * 5 + 1);
+    vec4 t2 = texelFetch(pointLightTexels, i * 5 + 2);
+    vec4 t3 = texelFetch(pointLightTexels, i * 5 + 3);
+    vec4 t4 = texelFetch(pointLightTexels, i * 5 + 4);
+    return PointLight(t0.xyz, t1.xyz, t2.xyz, t3.xyz, t3.w, t4.x, t4.y);
+}
+#else
+PointLight fetchPointLight(int i) {
+    return pointLights[i];
+}
+#endif
+
+layout (std140) uniform MaterialParams {
+    float shininess;
+};
+
+uniform vec3 viewPos;
+
+vec3 calcDirectionalLight(DirLight light, vec3 normal, vec3 viewDir) {
+    vec3 lightDir = normalize(-light.direction);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    return light.ambient + light.diffuse * diff + light.specular * spec;
+}
+
+vec3 calcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.position - fragPos);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    return (light.ambient + light.diffuse * diff + light.specular * spec) * attenuation;
+}
+
+void main() {
+    vec3 viewDir = normalize(viewPos - fragPos);
+    vec3 color = calcDirectionalLight(dirLight, vec3(0.0, 1.0, 0.0), viewDir);
+#ifdef POINT_LIGHTS_TEXTURE_BUFFER
+    for (int i = 0; i < numPointLights; ++i)
+#else
+    for (int i = 0; i < MAX_POINT_LIGHTS; ++i)
+#endif
+        color += calcPointLight(fetchPointLight(i), vec3(0.0, 1.0, 0.0), fragPos, viewDir);
+    fragColor = vec4(color, 1.0);
+}
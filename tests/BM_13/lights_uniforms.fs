@@ -0,0 +1,53 @@
+#version 330 core
+
+in vec3 fragPos;
+
+out vec4 fragColor;
+
+struct DirLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+struct PointLight {
+    vec3 position;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+uniform DirLight dirLight;
+uniform PointLight pointLights[NUMBER_POINT_LIGHTS];
+uniform float shininess;
+uniform vec3 viewPos;
+
+vec3 calcDirectionalLight(DirLight light, vec3 normal, vec3 viewDir) {
+    vec3 lightDir = normalize(-light.direction);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    return light.ambient + light.diffuse * diff + light.specular * spec;
+}
+
+vec3 calcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.position - fragPos);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    return (light.ambient + light.diffuse * diff + light.specular * spec) * attenuation;
+}
+
+void main() {
+    vec3 viewDir = normalize(viewPos - fragPos);
+    vec3 color = calcDirectionalLight(dirLight, vec3(0.0, 1.0, 0.0), viewDir);
+    for (int i = 0; i < NUMBER_POINT_LIGHTS; ++i)
+        color += calcPointLight(pointLights[i], vec3(0.0, 1.0, 0.0), fragPos, viewDir);
+    fragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,259 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "shader.h"
+#include "light_uniforms.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 640;
+uint32_t screen_height = 360;
+
+std::string projectDir = "../tests/BM_13";
+
+const uint32_t k_Frames = 100;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct LightStats {
+	double uploadMs; // CPU time spent handing the lights to GL
+	double frameMs;
+	double uniformCalls;
+	double bufferUploads;
+};
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+uint32_t createPlane()
+{
+	const float vertices[] = { -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f };
+
+	uint32_t VAO, VBO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glBindVertexArray(0);
+	return VAO;
+}
+
+DirLight createDirLight()
+{
+	DirLight light = {};
+	light.direction = glm::vec3(-0.2f, -1.0f, -0.3f);
+	light.ambient = glm::vec3(0.01f);
+	light.diffuse = glm::vec3(0.15f);
+	light.specular = glm::vec3(0.5f);
+	return light;
+}
+
+// Lights on a grid above the plane, moving every frame so every upload carries new values
+std::vector<PointLight> createPointLights(const uint32_t count, const uint32_t frame)
+{
+	std::vector<PointLight> lights(count);
+	const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+	for (uint32_t i = 0; i < count; i++)
+	{
+		PointLight& light = lights[i];
+		const float x = ((i % side) + 0.5f) / side * 40.0f - 20.0f;
+		const float z = ((i / side) + 0.5f) / side * 40.0f - 20.0f;
+		light.position = glm::vec3(x + std::sin(frame * 0.05f + i), 1.0f, z);
+		light.ambient = glm::vec3(0.0f);
+		light.diffuse = glm::vec3((i % 3) == 0, (i % 3) == 1, (i % 3) == 2) * 0.5f;
+		light.specular = glm::vec3(0.2f);
+		light.constant = 1.0f;
+		light.linear = 0.7f;
+		light.quadratic = 1.8f;
+	}
+	return lights;
+}
+
+// Field by field with a name built per field, the way AG_08_05 set its two lights
+LightStats drawWithUniforms(const Shader& shader, const uint32_t count, const uint32_t VAO, const glm::mat4& viewProj, const glm::vec3& viewPos)
+{
+	LightStats stats = { 0.0, 0.0, 0.0, 0.0 };
+	Shader::resetUniformStats();
+	glBindVertexArray(VAO);
+	for (uint32_t f = 0; f < k_Frames; f++)
+	{
+		const std::vector<PointLight> lights = createPointLights(count, f);
+		const auto start = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT);
+		shader.use();
+		shader.set("viewProj", viewProj);
+		shader.set("viewPos", viewPos);
+		shader.set("shininess", 32.0f);
+
+		const DirLight dirLight = createDirLight();
+		shader.set("dirLight.direction", dirLight.direction);
+		shader.set("dirLight.ambient", dirLight.ambient);
+		shader.set("dirLight.diffuse", dirLight.diffuse);
+		shader.set("dirLight.specular", dirLight.specular);
+
+		char name[64];
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const PointLight& light = lights[i];
+			std::snprintf(name, sizeof(name), "pointLights[%u].position", i);
+			shader.set(name, light.position);
+			std::snprintf(name, sizeof(name), "pointLights[%u].ambient", i);
+			shader.set(name, light.ambient);
+			std::snprintf(name, sizeof(name), "pointLights[%u].diffuse", i);
+			shader.set(name, light.diffuse);
+			std::snprintf(name, sizeof(name), "pointLights[%u].specular", i);
+			shader.set(name, light.specular);
+			std::snprintf(name, sizeof(name), "pointLights[%u].constant", i);
+			shader.set(name, light.constant);
+			std::snprintf(name, sizeof(name), "pointLights[%u].linear", i);
+			shader.set(name, light.linear);
+			std::snprintf(name, sizeof(name), "pointLights[%u].quadratic", i);
+			shader.set(name, light.quadratic);
+		}
+		stats.uploadMs += elapsedMs(start);
+
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		glFinish();
+		stats.frameMs += elapsedMs(start);
+	}
+	glBindVertexArray(0);
+
+	stats.uploadMs /= k_Frames;
+	stats.frameMs /= k_Frames;
+	stats.uniformCalls = (double)(Shader::uniformStats().issued + Shader::uniformStats().skipped) / k_Frames;
+	return stats;
+}
+
+// The whole array in one upload through LightUniforms
+LightStats drawWithBuffer(const Shader& shader, LightUniforms& lightUniforms, const uint32_t count, const uint32_t VAO, const glm::mat4& viewProj, const glm::vec3& viewPos)
+{
+	LightStats stats = { 0.0, 0.0, 0.0, 0.0 };
+	Shader::resetUniformStats();
+	glBindVertexArray(VAO);
+	for (uint32_t f = 0; f < k_Frames; f++)
+	{
+		const std::vector<PointLight> lights = createPointLights(count, f);
+		const auto start = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT);
+		shader.use();
+		shader.set("viewProj", viewProj);
+		shader.set("viewPos", viewPos);
+
+		lightUniforms.setDirLight(createDirLight());
+		lightUniforms.setPointLights(lights.data(), count);
+		lightUniforms.upload();
+		stats.bufferUploads += 2; // block header and point light array
+		stats.uploadMs += elapsedMs(start);
+
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		glFinish();
+		stats.frameMs += elapsedMs(start);
+	}
+	glBindVertexArray(0);
+
+	stats.uploadMs /= k_Frames;
+	stats.frameMs /= k_Frames;
+	stats.uniformCalls = (double)(Shader::uniformStats().issued + Shader::uniformStats().skipped) / k_Frames;
+	stats.bufferUploads /= k_Frames;
+	return stats;
+}
+
+void print(const char* label, const LightStats& stats)
+{
+	std::cout << "  " << label << stats.uploadMs << " ms upload, " << stats.frameMs << " ms frame, "
+		<< stats.uniformCalls << " uniform sets, " << stats.bufferUploads << " buffer uploads per frame" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_13", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	std::cout << "GL_MAX_UNIFORM_BLOCK_SIZE: " << StructBuffer::maxUniformBlockSize() << " bytes" << std::endl;
+
+	{ // GL objects must go away before the context
+		const uint32_t VAO = createPlane();
+		const glm::vec3 viewPos(0.0f, 25.0f, 25.0f);
+		const glm::mat4 viewProj = glm::perspective(glm::radians(45.0f), (float)screen_width / screen_height, 0.1f, 100.0f) *
+			glm::lookAt(viewPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		MaterialParams materialParams = {};
+		materialParams.shininess = 32.0f;
+		StructBuffer material(StructBuffer::Storage::UniformBlock, k_MaterialBlockBinding, sizeof(MaterialParams));
+		material.upload(&materialParams, 1);
+
+		ShaderVariants uniformShaders((projectDir + "/lights.vs").c_str(), (projectDir + "/lights_uniforms.fs").c_str());
+		ShaderVariants blockShaders((projectDir + "/lights.vs").c_str(), (projectDir + "/lights_block.fs").c_str());
+
+		const uint32_t counts[3] = { 2, 64, 512 };
+		for (const uint32_t count : counts)
+		{
+			std::cout << count << " point lights" << std::endl;
+
+			// Large arrays run past GL_MAX_FRAGMENT_UNIFORM_COMPONENTS and fail to link
+			const Shader& uniformShader = uniformShaders.get({ { "NUMBER_POINT_LIGHTS", std::to_string(count) } });
+			const std::string lastLight = "pointLights[" + std::to_string(count - 1) + "].position";
+			if (uniformShader.uniform(lastLight.c_str()).slot >= 0)
+			{
+				print("Per-field uniforms: ", drawWithUniforms(uniformShader, count, VAO, viewProj, viewPos));
+			}
+			else
+			{
+				std::cout << "  Per-field uniforms: the array does not fit in the default uniform block" << std::endl;
+			}
+
+			LightUniforms lightUniforms(count);
+			const Shader& blockShader = blockShaders.get(lightUniforms.defines());
+			const bool textureBuffer = lightUniforms.storage() == StructBuffer::Storage::TextureBuffer;
+			print(textureBuffer ? "Texture buffer:     " : "Uniform block:      ",
+				drawWithBuffer(blockShader, lightUniforms, count, VAO, viewProj, viewPos));
+		}
+		glDeleteVertexArrays(1, &VAO);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include "shader.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string testsDir = "../tests";
+
+// Program requests of a scene with several passes: the post-processing programs share
+// fbo.vs, and the scene program is asked for once per pass that draws the cubes
+const char* k_Requests[][2] = {
+	{ "AG_12_02/cube.vs", "AG_12_02/cube.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_blur.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_border_detection.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_grayscale.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_invert.fs" },
+	{ "AG_12_02/fbo.vs", "AG_12_02/fbo_sharpen.fs" },
+	{ "AG_12_02/cube.vs", "AG_12_02/cube.fs" },
+	{ "AG_13/depth.vs", "AG_13/depth.fs" },
+	{ "AG_13/cube.vs", "AG_13/cube.fs" },
+	{ "AG_13/depth.vs", "AG_13/depth.fs" },
+	{ "AG_12_02/cube.vs", "AG_12_02/cube.fs" },
+	{ "AG_13/cube.vs", "AG_13/cube.fs" }
+};
+
+#pragma region Functions: for Benchmark
+
+// Creates a program per request, through the library or with its own Shader
+void startup(const char* label, const bool library)
+{
+	Shader::clearStageCache();
+	Shader::resetProgramCacheStats();
+	const uint64_t hits = ShaderLibrary::instance().hits();
+	const auto start = std::chrono::high_resolution_clock::now();
+	{
+		std::vector<std::shared_ptr<const Shader>> programs;
+		for (const auto& request : k_Requests)
+		{
+			const std::string vertexPath = testsDir + "/" + request[0];
+			const std::string fragmentPath = testsDir + "/" + request[1];
+			if (library)
+			{
+				programs.push_back(ShaderLibrary::instance().get(vertexPath.c_str(), fragmentPath.c_str()));
+			}
+			else
+			{
+				programs.push_back(std::make_shared<const Shader>(vertexPath.c_str(), fragmentPath.c_str()));
+			}
+		}
+		glFinish();
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	const ProgramCacheStats& stats = Shader::programCacheStats();
+	std::cout << label << ": " << std::chrono::duration<double, std::milli>(end - start).count() << " ms for "
+		<< sizeof(k_Requests) / sizeof(k_Requests[0]) << " requests" << std::endl;
+	std::cout << "  programs linked " << stats.misses << ", reused " << ShaderLibrary::instance().hits() - hits
+		<< ", stages compiled " << stats.stagesCompiled << ", shared " << stats.stagesShared << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_14", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	// Binaries would skip the compile this is about
+	Shader::setProgramCacheDir("");
+
+	Shader::setStageSharing(false);
+	startup("Every program on its own", false);
+
+	Shader::setStageSharing(true);
+	startup("Shared stages", false);
+	startup("Shared stages and ShaderLibrary", true);
+
+	Shader::clearStageCache();
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "shader.h"
+#include "model.h"
+#include "gl_state.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_15";
+std::string assetsDir = "../assets";
+
+const uint32_t k_Frames = 100;
+const uint32_t k_Copies = 32;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct StateRun {
+	double frameMs;
+	double issued; // per frame
+	double elided;
+};
+
+#pragma region Functions: for Benchmark
+
+glm::mat4 copyTransform(const uint32_t i)
+{
+	const float angle = (float)i / k_Copies * 2.0f * glm::pi<float>();
+	const glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(std::cos(angle) * 6.0f, 0.0f, std::sin(angle) * 6.0f));
+	return glm::scale(model, glm::vec3(0.3f));
+}
+
+StateRun drawFrames(const Model& object, const Shader& shader, const Shader& outlineShader, const bool elision)
+{
+	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), (float)screen_width / screen_height, 0.1f, 100.0f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 8.0f, 14.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	GLState& state = GLState::instance();
+	state.setElision(elision);
+	state.invalidate();
+
+	StateRun run = { 0.0, 0.0, 0.0 };
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		state.resetStats();
+		const auto start = Clock::now();
+		state.stencilMask(0xFF); // glClear honours the stencil write mask
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+		for (uint32_t i = 0; i < k_Copies; i++)
+		{
+			const glm::mat4 model = copyTransform(i);
+
+			// Opaque pass, marking the stencil
+			state.setDepthTest(true);
+			state.depthFunc(GL_LESS);
+			state.setCullFace(true);
+			state.cullFace(GL_BACK);
+			state.setBlend(false);
+			state.setStencilTest(true);
+			state.stencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+			state.stencilFunc(GL_ALWAYS, 1, 0xFF);
+			state.stencilMask(0xFF);
+			shader.use();
+			shader.set("projection", proj);
+			shader.set("view", view);
+			shader.set("model", model);
+			shader.set("outline", 0.0f);
+			shader.set("lightDir", glm::normalize(glm::vec3(-0.2f, -1.0f, -0.3f)));
+			object.Draw(shader);
+
+			// Translucent outline around the unmarked pixels
+			state.stencilFunc(GL_NOTEQUAL, 1, 0xFF);
+			state.stencilMask(0x00);
+			state.setDepthTest(false);
+			state.setBlend(true);
+			state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			outlineShader.use();
+			outlineShader.set("projection", proj);
+			outlineShader.set("view", view);
+			outlineShader.set("model", model);
+			outlineShader.set("outline", 0.05f);
+			outlineShader.set("outlineColor", glm::vec4(1.0f, 0.6f, 0.1f, 0.5f));
+			object.Draw(outlineShader);
+
+			// Back to the opaque state, as the render loops of AG_10 do by hand
+			state.stencilMask(0xFF);
+			state.stencilFunc(GL_ALWAYS, 1, 0xFF);
+			state.setDepthTest(true);
+			state.setBlend(false);
+		}
+
+		glFinish();
+		run.frameMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		run.issued += (double)state.stats().issued;
+		run.elided += (double)state.stats().elided;
+	}
+	state.setElision(true);
+
+	run.frameMs /= k_Frames;
+	run.issued /= k_Frames;
+	run.elided /= k_Frames;
+	return run;
+}
+
+void print(const char* label, const StateRun& run)
+{
+	std::cout << "  " << label << run.issued << " issued, " << run.elided << " elided state changes per frame, "
+		<< run.frameMs << " ms frame" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_15", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	{ // GL objects must go away before the context
+		const Shader shader((projectDir + "/model.vs").c_str(), (projectDir + "/model.fs").c_str());
+		const Shader outlineShader((projectDir + "/model.vs").c_str(), (projectDir + "/outline.fs").c_str());
+		const Model object(assetsDir + "/Freighter/Freigther_BI_Export.obj");
+
+		std::cout << k_Copies << " Freighters with outlines, " << k_Frames << " frames" << std::endl;
+		drawFrames(object, shader, outlineShader, true); // warm up
+		print("Elision off: ", drawFrames(object, shader, outlineShader, false));
+		print("Elision on:  ", drawFrames(object, shader, outlineShader, true));
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,15 @@
+#version 330 core
+
+in vec3 normal;
+in vec2 textCoords;
+
+out vec4 fragColor;
+
+uniform sampler2D texture_diffuse1;
+uniform vec3 lightDir;
+
+void main() {
+    vec3 color = vec3(texture(texture_diffuse1, textCoords));
+    float diff = max(dot(normalize(normal), -lightDir), 0.0);
+    fragColor = vec4(color * (0.2 + 0.8 * diff), 1.0);
+}
@@ -0,0 +1,18 @@
+#version 330 core
+layout (location=0) in vec3 aPos;
+layout (location=1) in vec3 aNormal;
+layout (location=2) in vec2 aTextCoords;
+
+out vec3 normal;
+out vec2 textCoords;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float outline;
+
+void main() {
+    normal = mat3(model) * aNormal;
+    textCoords = aTextCoords;
+    gl_Position = projection * view * model * vec4(aPos + aNormal * outline, 1.0);
+}
@@ -0,0 +1,287 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include "shader.h"
+#include "gl_state.h"
+#include "render_queue.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_16";
+
+const uint32_t k_Frames = 100;
+const uint32_t k_Objects = 4096;
+const uint32_t k_Textures = 8;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct SceneObject {
+	const Shader* shader;
+	uint32_t VAO;
+	uint32_t count;
+	uint32_t textures[2];
+	glm::mat4 model;
+	RenderPass pass;
+};
+
+struct QueueRun {
+	RenderQueueStats queue; // per frame
+	double issued; // GL state changes per frame
+	double frameMs;
+};
+
+#pragma region Functions: for Benchmark
+
+uint32_t createVertexData(const float* vertices, const uint32_t n_verts, const uint32_t* indices, const uint32_t n_indices)
+{
+	uint32_t VAO, VBO, EBO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+
+	GLState::instance().bindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, n_verts * 8 * sizeof(float), vertices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, n_indices * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+	glEnableVertexAttribArray(2);
+
+	GLState::instance().bindVertexArray(0);
+	return VAO;
+}
+
+uint32_t createCube()
+{
+	const float vertices[] = { // Position // Normal // Texture Coords
+		-0.5f, -0.5f, 0.5f,		0.0f, 0.0f, 1.0f,		0.0f, 0.0f, // Front
+		0.5f, -0.5f, 0.5f,		0.0f, 0.0f, 1.0f,		1.0f, 0.0f,
+		0.5f, 0.5f, 0.5f,		0.0f, 0.0f, 1.0f,		1.0f, 1.0f,
+		-0.5f, 0.5f, 0.5f,		0.0f, 0.0f, 1.0f,		0.0f, 1.0f,
+		0.5f, -0.5f, 0.5f,		1.0f, 0.0f, 0.0f,		0.0f, 0.0f, // Right
+		0.5f, -0.5f, -0.5f,		1.0f, 0.0f, 0.0f,		1.0f, 0.0f,
+		0.5f, 0.5f, -0.5f,		1.0f, 0.0f, 0.0f,		1.0f, 1.0f,
+		0.5f, 0.5f, 0.5f,		1.0f, 0.0f, 0.0f,		0.0f, 1.0f,
+		0.5f, -0.5f, -0.5f,		0.0f, 0.0f, -1.0f,		0.0f, 0.0f, // Back
+		-0.5f, -0.5f, -0.5f,	0.0f, 0.0f, -1.0f,		1.0f, 0.0f,
+		-0.5f, 0.5f, -0.5f,		0.0f, 0.0f, -1.0f,		1.0f, 1.0f,
+		0.5f, 0.5f, -0.5f,		0.0f, 0.0f, -1.0f,		0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,	-1.0f, 0.0f, 0.0f,		0.0f, 0.0f, // Left
+		-0.5f, -0.5f, 0.5f,		-1.0f, 0.0f, 0.0f,		1.0f, 0.0f,
+		-0.5f, 0.5f, 0.5f,		-1.0f, 0.0f, 0.0f,		1.0f, 1.0f,
+		-0.5f, 0.5f, -0.5f,		-1.0f, 0.0f, 0.0f,		0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,	0.0f, -1.0f, 0.0f,		0.0f, 0.0f, // Bottom
+		0.5f, -0.5f, -0.5f,		0.0f, -1.0f, 0.0f,		1.0f, 0.0f,
+		0.5f, -0.5f, 0.5f,		0.0f, -1.0f, 0.0f,		1.0f, 1.0f,
+		-0.5f, -0.5f, 0.5f,		0.0f, -1.0f, 0.0f,		0.0f, 1.0f,
+		-0.5f, 0.5f, 0.5f,		0.0f, 1.0f, 0.0f,		0.0f, 0.0f, // Top
+		0.5f, 0.5f, 0.5f,		0.0f, 1.0f, 0.0f,		1.0f, 0.0f,
+		0.5f, 0.5f, -0.5f,		0.0f, 1.0f, 0.0f,		1.0f, 1.0f,
+		-0.5f, 0.5f, -0.5f,		0.0f, 1.0f, 0.0f,		0.0f, 1.0f
+	};
+	uint32_t indices[36];
+	for (uint32_t face = 0; face < 6; face++)
+	{
+		const uint32_t quad[6] = { 0, 1, 2, 0, 2, 3 };
+		for (uint32_t i = 0; i < 6; i++) indices[face * 6 + i] = face * 4 + quad[i];
+	}
+	return createVertexData(vertices, 24, indices, 36);
+}
+
+uint32_t createQuad()
+{
+	const float vertices[] = { // Position // Normal // Texture Coords
+		-0.5f, 0.0f, 0.5f,		0.0f, 1.0f, 0.0f,		0.0f, 0.0f,
+		0.5f, 0.0f, 0.5f,		0.0f, 1.0f, 0.0f,		1.0f, 0.0f,
+		0.5f, 0.0f, -0.5f,		0.0f, 1.0f, 0.0f,		1.0f, 1.0f,
+		-0.5f, 0.0f, -0.5f,		0.0f, 1.0f, 0.0f,		0.0f, 1.0f
+	};
+	const uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+	return createVertexData(vertices, 4, indices, 6);
+}
+
+// Checkerboard in a colour of its own
+uint32_t createTexture(const uint32_t index)
+{
+	const uint32_t size = 64;
+	std::vector<uint8_t> texels(size * size * 3);
+	for (uint32_t y = 0; y < size; y++)
+	{
+		for (uint32_t x = 0; x < size; x++)
+		{
+			const bool odd = ((x / 8) + (y / 8)) % 2 == 1;
+			uint8_t* texel = &texels[(y * size + x) * 3];
+			texel[0] = odd ? 255 : static_cast<uint8_t>(index * 32);
+			texel[1] = odd ? 255 : static_cast<uint8_t>(255 - index * 32);
+			texel[2] = odd ? 255 : static_cast<uint8_t>((index * 97) % 256);
+		}
+	}
+
+	uint32_t texture;
+	glGenTextures(1, &texture);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, size, size, 0, GL_RGB, GL_UNSIGNED_BYTE, texels.data());
+	glGenerateMipmap(GL_TEXTURE_2D);
+	return texture;
+}
+
+// Objects on a grid with random shapes, programs and texture sets, in shuffled order
+std::vector<SceneObject> createScene(const Shader* opaque[2], const Shader& blended, const uint32_t VAOs[2], const uint32_t* textures)
+{
+	std::mt19937 rng(1234);
+	std::vector<SceneObject> objects(k_Objects);
+	const uint32_t side = 64;
+	for (uint32_t i = 0; i < k_Objects; i++)
+	{
+		SceneObject& object = objects[i];
+		const uint32_t shape = rng() % 2;
+		object.pass = rng() % 8 == 0 ? RenderPass::Blended : RenderPass::Opaque;
+		object.shader = object.pass == RenderPass::Blended ? &blended : opaque[rng() % 2];
+		object.VAO = VAOs[shape];
+		object.count = shape == 0 ? 36 : 6;
+		object.textures[0] = textures[rng() % 4];
+		object.textures[1] = textures[4 + rng() % 4];
+		const glm::vec3 position(((i % side) - side * 0.5f) * 1.5f, 0.0f, -((i / side) * 1.5f) - 2.0f);
+		object.model = glm::translate(glm::mat4(1.0f), position);
+	}
+	std::shuffle(objects.begin(), objects.end(), rng);
+	return objects;
+}
+
+QueueRun drawFrames(RenderQueue& queue, const std::vector<SceneObject>& objects, const Shader* programs[3], const bool sorting)
+{
+	const glm::vec3 viewPos(0.0f, 12.0f, 8.0f);
+	const glm::mat4 view = glm::lookAt(viewPos, glm::vec3(0.0f, 0.0f, -40.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 proj = glm::perspective(glm::radians(60.0f), (float)screen_width / screen_height, 0.1f, 150.0f);
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		programs[i]->use();
+		programs[i]->set("viewProj", proj * view);
+		programs[i]->set("albedo", 0);
+		programs[i]->set("detail", 1);
+	}
+
+	GLState& state = GLState::instance();
+	queue.setSorting(sorting);
+	QueueRun run = {};
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		state.resetStats();
+		const auto start = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		queue.begin(view, 0.1f, 150.0f);
+		for (const SceneObject& object : objects)
+			queue.enqueue(*object.shader, object.VAO, object.count, object.model, object.pass, object.textures, 2);
+		queue.submit();
+
+		glFinish();
+		run.frameMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		run.issued += (double)state.stats().issued;
+		run.queue.programChanges += queue.stats().programChanges;
+		run.queue.materialChanges += queue.stats().materialChanges;
+		run.queue.VAOChanges += queue.stats().VAOChanges;
+		run.queue.sortMs += queue.stats().sortMs;
+	}
+	queue.setSorting(true);
+
+	run.frameMs /= k_Frames;
+	run.issued /= k_Frames;
+	run.queue.programChanges /= k_Frames;
+	run.queue.materialChanges /= k_Frames;
+	run.queue.VAOChanges /= k_Frames;
+	run.queue.sortMs /= k_Frames;
+	return run;
+}
+
+void print(const char* label, const QueueRun& run)
+{
+	std::cout << label << std::endl;
+	std::cout << "  Program changes:     " << run.queue.programChanges << std::endl;
+	std::cout << "  Texture set changes: " << run.queue.materialChanges << std::endl;
+	std::cout << "  VAO changes:         " << run.queue.VAOChanges << std::endl;
+	std::cout << "  GL state changes:    " << run.issued << std::endl;
+	std::cout << "  Sort: " << run.queue.sortMs << " ms, frame: " << run.frameMs << " ms" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_16", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	GLState::instance().setDepthTest(true);
+	GLState::instance().setCullFace(true);
+
+	{ // GL objects must go away before the context
+		ShaderVariants variants((projectDir + "/object.vs").c_str(), (projectDir + "/object.fs").c_str());
+		const Shader* programs[3] = {
+			&variants.get({}),
+			&variants.get({ { "HALF_LAMBERT", "" } }),
+			&variants.get({ { "BLENDED", "" } })
+		};
+
+		const uint32_t VAOs[2] = { createCube(), createQuad() };
+		uint32_t textures[k_Textures];
+		for (uint32_t i = 0; i < k_Textures; i++) textures[i] = createTexture(i);
+
+		const std::vector<SceneObject> objects = createScene(programs, *programs[2], VAOs, textures);
+
+		RenderQueue queue;
+		std::cout << k_Objects << " objects, " << k_Frames << " frames" << std::endl;
+		drawFrames(queue, objects, programs, true); // warm up
+		print("Submission order:", drawFrames(queue, objects, programs, false));
+		print("Sorted by key:", drawFrames(queue, objects, programs, true));
+
+		glDeleteTextures(k_Textures, textures);
+		glDeleteVertexArrays(2, VAOs);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+in vec3 normal;
+in vec2 textCoords;
+
+out vec4 fragColor;
+
+uniform sampler2D albedo;
+uniform sampler2D detail;
+
+void main() {
+    vec3 color = texture(albedo, textCoords).rgb * texture(detail, textCoords * 4.0).rgb;
+#ifdef HALF_LAMBERT
+    float diff = dot(normalize(normal), vec3(0.0, 1.0, 0.0)) * 0.5 + 0.5;
+#else
+    float diff = max(dot(normalize(normal), vec3(0.0, 1.0, 0.0)), 0.2);
+#endif
+#ifdef BLENDED
+    fragColor = vec4(color * diff, 0.4);
+#else
+    fragColor = vec4(color * diff, 1.0);
+#endif
+}
@@ -0,0 +1,16 @@
+#version 330 core
+layout (location=0) in vec3 aPos;
+layout (location=1) in vec3 aNormal;
+layout (location=2) in vec2 aTextCoords;
+
+out vec3 normal;
+out vec2 textCoords;
+
+uniform mat4 model;
+uniform mat4 viewProj;
+
+void main() {
+    normal = mat3(model) * aNormal;
+    textCoords = aTextCoords;
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
@@ -0,0 +1,25 @@
+#version 330 core
+layout (location=0) in vec3 aPos;
+layout (location=1) in vec3 aNormal;
+
+#ifdef INSTANCED
+layout (location = 5) in mat4 aInstanceModel;
+layout (location = 9) in mat3 aInstanceNormalMat;
+#else
+uniform mat4 model;
+uniform mat3 normalMat;
+#endif
+
+uniform mat4 viewProj;
+
+out vec3 normal;
+
+void main() {
+#ifdef INSTANCED
+    normal = aInstanceNormalMat * aNormal;
+    gl_Position = viewProj * aInstanceModel * vec4(aPos, 1.0);
+#else
+    normal = normalMat * aNormal;
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+#endif
+}
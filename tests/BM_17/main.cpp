@@ -0,0 +1,218 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "shader.h"
+#include "gl_state.h"
+#include "instance_buffer.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_17";
+
+const uint32_t k_Frames = 20;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct DrawTimes {
+	double submitMs; // CPU: matrices and GL calls
+	double frameMs;
+};
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+uint32_t createCube()
+{
+	const float vertices[] = { // Position // Normal
+		-0.5f, -0.5f, 0.5f,		0.0f, 0.0f, 1.0f, // Front
+		0.5f, -0.5f, 0.5f,		0.0f, 0.0f, 1.0f,
+		0.5f, 0.5f, 0.5f,		0.0f, 0.0f, 1.0f,
+		-0.5f, 0.5f, 0.5f,		0.0f, 0.0f, 1.0f,
+		0.5f, -0.5f, 0.5f,		1.0f, 0.0f, 0.0f, // Right
+		0.5f, -0.5f, -0.5f,		1.0f, 0.0f, 0.0f,
+		0.5f, 0.5f, -0.5f,		1.0f, 0.0f, 0.0f,
+		0.5f, 0.5f, 0.5f,		1.0f, 0.0f, 0.0f,
+		0.5f, -0.5f, -0.5f,		0.0f, 0.0f, -1.0f, // Back
+		-0.5f, -0.5f, -0.5f,	0.0f, 0.0f, -1.0f,
+		-0.5f, 0.5f, -0.5f,		0.0f, 0.0f, -1.0f,
+		0.5f, 0.5f, -0.5f,		0.0f, 0.0f, -1.0f,
+		-0.5f, -0.5f, -0.5f,	-1.0f, 0.0f, 0.0f, // Left
+		-0.5f, -0.5f, 0.5f,		-1.0f, 0.0f, 0.0f,
+		-0.5f, 0.5f, 0.5f,		-1.0f, 0.0f, 0.0f,
+		-0.5f, 0.5f, -0.5f,		-1.0f, 0.0f, 0.0f,
+		-0.5f, -0.5f, -0.5f,	0.0f, -1.0f, 0.0f, // Bottom
+		0.5f, -0.5f, -0.5f,		0.0f, -1.0f, 0.0f,
+		0.5f, -0.5f, 0.5f,		0.0f, -1.0f, 0.0f,
+		-0.5f, -0.5f, 0.5f,		0.0f, -1.0f, 0.0f,
+		-0.5f, 0.5f, 0.5f,		0.0f, 1.0f, 0.0f, // Top
+		0.5f, 0.5f, 0.5f,		0.0f, 1.0f, 0.0f,
+		0.5f, 0.5f, -0.5f,		0.0f, 1.0f, 0.0f,
+		-0.5f, 0.5f, -0.5f,		0.0f, 1.0f, 0.0f
+	};
+	uint32_t indices[36];
+	for (uint32_t face = 0; face < 6; face++)
+	{
+		const uint32_t quad[6] = { 0, 1, 2, 0, 2, 3 };
+		for (uint32_t i = 0; i < 6; i++) indices[face * 6 + i] = face * 4 + quad[i];
+	}
+
+	uint32_t VAO, VBO, EBO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+	GLState::instance().bindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	GLState::instance().bindVertexArray(0);
+	return VAO;
+}
+
+// Cube i of a square grid, spinning with the frame
+glm::mat4 cubeTransform(const uint32_t i, const uint32_t count, const uint32_t frame)
+{
+	const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+	const float spacing = 100.0f / side;
+	const glm::vec3 position(((i % side) + 0.5f) * spacing - 50.0f, 0.0f, ((i / side) + 0.5f) * spacing - 50.0f);
+	glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+	model = glm::rotate(model, frame * 0.05f + i, glm::vec3(0.0f, 1.0f, 0.0f));
+	return glm::scale(model, glm::vec3(spacing * 0.5f));
+}
+
+DrawTimes drawPerCube(const Shader& shader, const uint32_t VAO, const uint32_t count, const glm::mat4& viewProj)
+{
+	DrawTimes times = { 0.0, 0.0 };
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		shader.use();
+		shader.set("viewProj", viewProj);
+		GLState::instance().bindVertexArray(VAO);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::mat4 model = cubeTransform(i, count, frame);
+			shader.set("model", model);
+			shader.set("normalMat", glm::transpose(glm::inverse(glm::mat3(model))));
+			glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+		}
+		times.submitMs += elapsedMs(start);
+		glFinish();
+		times.frameMs += elapsedMs(start);
+	}
+	times.submitMs /= k_Frames;
+	times.frameMs /= k_Frames;
+	return times;
+}
+
+DrawTimes drawInstanced(const Shader& shader, const uint32_t VAO, InstanceBuffer& instances, const uint32_t count, const glm::mat4& viewProj)
+{
+	DrawTimes times = { 0.0, 0.0 };
+	std::vector<glm::mat4> models(count);
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		shader.use();
+		shader.set("viewProj", viewProj);
+		for (uint32_t i = 0; i < count; i++)
+			models[i] = cubeTransform(i, count, frame);
+		instances.upload(models.data(), count);
+		instances.draw(VAO, 36);
+		times.submitMs += elapsedMs(start);
+		glFinish();
+		times.frameMs += elapsedMs(start);
+	}
+	times.submitMs /= k_Frames;
+	times.frameMs /= k_Frames;
+	return times;
+}
+
+void print(const char* label, const DrawTimes& times)
+{
+	std::cout << "  " << label << times.submitMs << " ms submit, " << times.frameMs << " ms frame" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_17", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	GLState::instance().setDepthTest(true);
+	GLState::instance().setCullFace(true);
+
+	{ // GL objects must go away before the context
+		ShaderVariants variants((projectDir + "/cube.vs").c_str(), (projectDir + "/cube.fs").c_str());
+		const Shader& perCube = variants.get({});
+		const Shader& instanced = variants.get({ { k_InstancedDefine, "" } });
+
+		const uint32_t VAO = createCube();
+		InstanceBuffer instances;
+		instances.attach(VAO);
+
+		const glm::mat4 viewProj = glm::perspective(glm::radians(60.0f), (float)screen_width / screen_height, 0.1f, 300.0f) *
+			glm::lookAt(glm::vec3(0.0f, 60.0f, 80.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		const uint32_t counts[5] = { 10, 100, 1000, 10000, 100000 };
+		for (const uint32_t count : counts)
+		{
+			std::cout << count << " cubes" << std::endl;
+			print("Draw per cube: ", drawPerCube(perCube, VAO, count, viewProj));
+			print("Instanced:     ", drawInstanced(instanced, VAO, instances, count, viewProj));
+		}
+
+		GLState::instance().forgetVertexArray(VAO);
+		glDeleteVertexArrays(1, &VAO);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,218 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "shader.h"
+#include "model.h"
+#include "gl_extensions.h"
+#include "gl_state.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_18";
+
+const uint32_t k_Frames = 50;
+const uint32_t k_TextureSets = 4;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct SubmitTimes {
+	double submitMs; // CPU: Model::Draw of both passes
+	double frameMs;
+	double calls; // indirect path GL calls per frame
+};
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Checkerboard in a colour of its own
+uint32_t createTexture(const uint32_t index)
+{
+	const uint32_t size = 64;
+	std::vector<uint8_t> texels(size * size * 3);
+	for (uint32_t y = 0; y < size; y++)
+	{
+		for (uint32_t x = 0; x < size; x++)
+		{
+			const bool odd = ((x / 8) + (y / 8)) % 2 == 1;
+			uint8_t* texel = &texels[(y * size + x) * 3];
+			texel[0] = odd ? 255 : static_cast<uint8_t>(index * 64);
+			texel[1] = odd ? 255 : static_cast<uint8_t>(255 - index * 64);
+			texel[2] = odd ? 255 : 128;
+		}
+	}
+
+	uint32_t texture;
+	glGenTextures(1, &texture);
+	GLState::instance().bindTexture(0, GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, size, size, 0, GL_RGB, GL_UNSIGNED_BYTE, texels.data());
+	glGenerateMipmap(GL_TEXTURE_2D);
+	return texture;
+}
+
+// Cube baked at its place in a square grid, with the texture of its set
+MeshData createCube(const uint32_t i, const uint32_t count, const uint32_t* textures)
+{
+	const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+	const float spacing = 100.0f / side;
+	const glm::vec3 center(((i % side) + 0.5f) * spacing - 50.0f, 0.0f, ((i / side) + 0.5f) * spacing - 50.0f);
+	const float half = spacing * 0.35f;
+
+	MeshData mesh;
+	const glm::vec3 normals[6] = {
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+		glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)
+	};
+	const glm::vec2 corners[4] = { glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f) };
+	for (uint32_t face = 0; face < 6; face++)
+	{
+		const glm::vec3 n = normals[face];
+		const glm::vec3 u = std::abs(n.y) > 0.5f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), n);
+		const glm::vec3 v = glm::cross(n, u);
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			Vertex vertex;
+			vertex.Position = center + (n + u * (corners[c].x * 2.0f - 1.0f) + v * (corners[c].y * 2.0f - 1.0f)) * half;
+			vertex.Normal = n;
+			vertex.TexCoords = corners[c];
+			vertex.Tangent = u;
+			vertex.Bitangent = v;
+			mesh.vertices.push_back(vertex);
+		}
+		const uint32_t quad[6] = { 0, 1, 2, 0, 2, 3 };
+		for (uint32_t k = 0; k < 6; k++) mesh.indices.push_back(face * 4 + quad[k]);
+	}
+
+	Texture texture;
+	texture.id = textures[i % k_TextureSets];
+	texture.type = "texture_diffuse";
+	mesh.textures.push_back(texture);
+	return mesh;
+}
+
+SubmitTimes drawFrames(const Model& scene, const Shader& shader, const Shader& depth, const glm::mat4& viewProj)
+{
+	shader.use();
+	shader.set("viewProj", viewProj);
+	depth.use();
+	depth.set("viewProj", viewProj);
+
+	SubmitTimes times = { 0.0, 0.0, 0.0 };
+	IndirectDrawList::resetStats();
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// Depth pre-pass, then the textured pass
+		GLState::instance().depthFunc(GL_LESS);
+		depth.use();
+		scene.Draw(depth);
+		GLState::instance().depthFunc(GL_LEQUAL);
+		shader.use();
+		scene.Draw(shader);
+
+		times.submitMs += elapsedMs(start);
+		glFinish();
+		times.frameMs += elapsedMs(start);
+	}
+	times.submitMs /= k_Frames;
+	times.frameMs /= k_Frames;
+	times.calls = (double)IndirectDrawList::stats().calls / k_Frames;
+	return times;
+}
+
+void print(const char* label, const SubmitTimes& times)
+{
+	std::cout << "  " << label << times.submitMs << " ms submit, " << times.frameMs << " ms frame";
+	if (times.calls > 0.0) std::cout << ", " << times.calls << " draw calls";
+	std::cout << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_18", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	std::cout << (glExtensions().multiDrawIndirect ? "glMultiDrawElementsIndirect" : "glMultiDrawElementsBaseVertex fallback") << std::endl;
+
+	GLState::instance().setDepthTest(true);
+	GLState::instance().setCullFace(true);
+
+	{ // GL objects must go away before the context
+		const Shader shader((projectDir + "/scene.vs").c_str(), (projectDir + "/scene.fs").c_str());
+		const Shader depth((projectDir + "/depth.vs").c_str(), (projectDir + "/depth.fs").c_str());
+
+		uint32_t textures[k_TextureSets];
+		for (uint32_t i = 0; i < k_TextureSets; i++) textures[i] = createTexture(i);
+
+		const glm::mat4 viewProj = glm::perspective(glm::radians(60.0f), (float)screen_width / screen_height, 0.1f, 300.0f) *
+			glm::lookAt(glm::vec3(0.0f, 60.0f, 80.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		const uint32_t counts[4] = { 16, 256, 4096, 16384 };
+		for (const uint32_t count : counts)
+		{
+			std::vector<MeshData> meshes;
+			for (uint32_t i = 0; i < count; i++) meshes.push_back(createCube(i, count, textures));
+
+			ModelOptions options;
+			options.storage = StorageMode::Consolidated;
+			const Model perMesh(meshes, options);
+			options.indirect = true;
+			const Model indirect(meshes, options);
+
+			std::cout << count << " meshes" << std::endl;
+			print("Draw per mesh: ", drawFrames(perMesh, shader, depth, viewProj));
+			print("Indirect:      ", drawFrames(indirect, shader, depth, viewProj));
+		}
+
+		glDeleteTextures(k_TextureSets, textures);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
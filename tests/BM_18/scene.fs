@@ -0,0 +1,16 @@
+#version 330 core
+
+in vec3 normal;
+in vec2 textCoords;
+flat in uint materialIndex;
+
+out vec4 fragColor;
+
+uniform sampler2D texture_diffuse1;
+
+void main() {
+    // The material index tints every draw, so a wrong index shows up as a wrong colour
+    vec3 tint = vec3(float(materialIndex & 1u), float((materialIndex >> 1) & 1u), 1.0) * 0.5 + 0.5;
+    float diff = max(dot(normalize(normal), normalize(vec3(0.3, 1.0, 0.5))), 0.1);
+    fragColor = vec4(texture(texture_diffuse1, textCoords).rgb * tint * diff, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 330 core
+layout (location=0) in vec3 aPos;
+layout (location=1) in vec3 aNormal;
+layout (location=2) in vec2 aTextCoords;
+layout (location=12) in uint aMaterialIndex;
+
+out vec3 normal;
+out vec2 textCoords;
+flat out uint materialIndex;
+
+uniform mat4 viewProj;
+
+void main() {
+    normal = aNormal;
+    textCoords = aTextCoords;
+    materialIndex = aMaterialIndex;
+    gl_Position = viewProj * vec4(aPos, 1.0);
+}
@@ -0,0 +1,239 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "shader.h"
+#include "gl_state.h"
+#include "stream_buffer.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+std::string projectDir = "../tests/BM_19";
+
+const uint32_t k_Frames = 60;
+const uint32_t k_MaxObjects = 40000;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct StreamTimes {
+	double submitMs; // CPU per frame: matrices and GL calls
+	double frameMs; // wall time per frame over the whole run
+	uint64_t waits;
+};
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+uint32_t createCube()
+{
+	const float vertices[] = { // Position // Normal
+		-0.5f, -0.5f, 0.5f,		0.0f, 0.0f, 1.0f, // Front
+		0.5f, -0.5f, 0.5f,		0.0f, 0.0f, 1.0f,
+		0.5f, 0.5f, 0.5f,		0.0f, 0.0f, 1.0f,
+		-0.5f, 0.5f, 0.5f,		0.0f, 0.0f, 1.0f,
+		0.5f, -0.5f, 0.5f,		1.0f, 0.0f, 0.0f, // Right
+		0.5f, -0.5f, -0.5f,		1.0f, 0.0f, 0.0f,
+		0.5f, 0.5f, -0.5f,		1.0f, 0.0f, 0.0f,
+		0.5f, 0.5f, 0.5f,		1.0f, 0.0f, 0.0f,
+		0.5f, -0.5f, -0.5f,		0.0f, 0.0f, -1.0f, // Back
+		-0.5f, -0.5f, -0.5f,	0.0f, 0.0f, -1.0f,
+		-0.5f, 0.5f, -0.5f,		0.0f, 0.0f, -1.0f,
+		0.5f, 0.5f, -0.5f,		0.0f, 0.0f, -1.0f,
+		-0.5f, -0.5f, -0.5f,	-1.0f, 0.0f, 0.0f, // Left
+		-0.5f, -0.5f, 0.5f,		-1.0f, 0.0f, 0.0f,
+		-0.5f, 0.5f, 0.5f,		-1.0f, 0.0f, 0.0f,
+		-0.5f, 0.5f, -0.5f,		-1.0f, 0.0f, 0.0f,
+		-0.5f, -0.5f, -0.5f,	0.0f, -1.0f, 0.0f, // Bottom
+		0.5f, -0.5f, -0.5f,		0.0f, -1.0f, 0.0f,
+		0.5f, -0.5f, 0.5f,		0.0f, -1.0f, 0.0f,
+		-0.5f, -0.5f, 0.5f,		0.0f, -1.0f, 0.0f,
+		-0.5f, 0.5f, 0.5f,		0.0f, 1.0f, 0.0f, // Top
+		0.5f, 0.5f, 0.5f,		0.0f, 1.0f, 0.0f,
+		0.5f, 0.5f, -0.5f,		0.0f, 1.0f, 0.0f,
+		-0.5f, 0.5f, -0.5f,		0.0f, 1.0f, 0.0f
+	};
+	uint32_t indices[36];
+	for (uint32_t face = 0; face < 6; face++)
+	{
+		const uint32_t quad[6] = { 0, 1, 2, 0, 2, 3 };
+		for (uint32_t i = 0; i < 6; i++) indices[face * 6 + i] = face * 4 + quad[i];
+	}
+
+	uint32_t VAO, VBO, EBO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+	GLState::instance().bindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	GLState::instance().bindVertexArray(0);
+	return VAO;
+}
+
+// Cube i of a square grid, spinning with the frame
+glm::mat4 cubeTransform(const uint32_t i, const uint32_t count, const uint32_t frame)
+{
+	const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+	const float spacing = 100.0f / side;
+	const glm::vec3 position(((i % side) + 0.5f) * spacing - 50.0f, 0.0f, ((i / side) + 0.5f) * spacing - 50.0f);
+	glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+	model = glm::rotate(model, frame * 0.05f + i, glm::vec3(0.0f, 1.0f, 0.0f));
+	return glm::scale(model, glm::vec3(spacing * 0.5f));
+}
+
+StreamTimes drawWithUniforms(const Shader& shader, const uint32_t VAO, const uint32_t count, const glm::mat4& viewProj)
+{
+	StreamTimes times = { 0.0, 0.0, 0 };
+	const auto run = Clock::now();
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		shader.use();
+		shader.set("viewProj", viewProj);
+		GLState::instance().bindVertexArray(VAO);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::mat4 model = cubeTransform(i, count, frame);
+			shader.set("model", model);
+			shader.set("normalMat", glm::transpose(glm::inverse(glm::mat3(model))));
+			glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+		}
+		glFlush();
+		times.submitMs += elapsedMs(start);
+	}
+	glFinish();
+	times.frameMs = elapsedMs(run) / k_Frames;
+	times.submitMs /= k_Frames;
+	return times;
+}
+
+StreamTimes drawWithStream(const Shader& shader, StreamBuffer& stream, const uint32_t VAO, const uint32_t count, const glm::mat4& viewProj)
+{
+	StreamTimes times = { 0.0, 0.0, 0 };
+	std::vector<size_t> offsets(count);
+	stream.resetStats();
+	const auto run = Clock::now();
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = Clock::now();
+		stream.beginFrame();
+		for (uint32_t i = 0; i < count; i++)
+			offsets[i] = stream.push(objectData(cubeTransform(i, count, frame))).offset;
+		stream.flush();
+
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		shader.use();
+		shader.set("viewProj", viewProj);
+		GLState::instance().bindVertexArray(VAO);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			stream.bindRange(k_ObjectBlockBinding, offsets[i], sizeof(ObjectData));
+			glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+		}
+		stream.endFrame();
+		glFlush();
+		times.submitMs += elapsedMs(start);
+	}
+	glFinish();
+	times.frameMs = elapsedMs(run) / k_Frames;
+	times.submitMs /= k_Frames;
+	times.waits = stream.stats().waits;
+	return times;
+}
+
+void print(const char* label, const StreamTimes& times)
+{
+	std::cout << "  " << label << times.submitMs << " ms submit, " << times.frameMs << " ms frame, "
+		<< times.waits << " fence waits" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	if (!glfwInit()) // Initialize the GLFW library
+	{
+		std::cout << "Failed to initialize GLFW." << std::endl;
+		return -1;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); // Use OpenGL 3.3
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); // Use Core Profile
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only a context is needed
+
+	GLFWwindow* window = glfwCreateWindow(screen_width, screen_height, "BM_19", nullptr, nullptr);
+	if (!window)
+	{
+		std::cout << "Failed to create GLFW Window." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { // Initialize GLAD
+		std::cout << "Failed to initialize GLAD." << std::endl;
+		return -1;
+	}
+
+	GLState::instance().setDepthTest(true);
+	GLState::instance().setCullFace(true);
+
+	{ // GL objects must go away before the context
+		ShaderVariants variants((projectDir + "/object.vs").c_str(), (projectDir + "/object.fs").c_str());
+		const Shader& uniforms = variants.get({});
+		const Shader& block = variants.get({ { "OBJECT_BLOCK", "" } });
+
+		const uint32_t VAO = createCube();
+		const glm::mat4 viewProj = glm::perspective(glm::radians(60.0f), (float)screen_width / screen_height, 0.1f, 300.0f) *
+			glm::lookAt(glm::vec3(0.0f, 60.0f, 80.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		// Every allocation starts at a GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT multiple
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		const size_t frameBytes = k_MaxObjects * ((sizeof(ObjectData) + alignment - 1) / alignment * alignment);
+		StreamBuffer mapped(GL_UNIFORM_BUFFER, frameBytes, 3, StreamBuffer::Mode::Persistent);
+		StreamBuffer orphaning(GL_UNIFORM_BUFFER, frameBytes, 3, StreamBuffer::Mode::Orphaning);
+		if (mapped.mode() != StreamBuffer::Mode::Persistent)
+			std::cout << "No buffer storage, both stream buffers orphan" << std::endl;
+
+		const uint32_t counts[3] = { 1000, 10000, k_MaxObjects };
+		for (const uint32_t count : counts)
+		{
+			std::cout << count << " objects" << std::endl;
+			print("Uniforms:          ", drawWithUniforms(uniforms, VAO, count, viewProj));
+			print("Persistent stream: ", drawWithStream(block, mapped, VAO, count, viewProj));
+			print("Orphaning stream:  ", drawWithStream(block, orphaning, VAO, count, viewProj));
+		}
+
+		GLState::instance().forgetVertexArray(VAO);
+		glDeleteVertexArrays(1, &VAO);
+	}
+
+	// Exit
+	glfwTerminate();
+
+	return 0;
+}
@@ -0,0 +1,10 @@
+#version 330 core
+
+in vec3 normal;
+
+out vec4 fragColor;
+
+void main() {
+    float diff = max(dot(normalize(normal), normalize(vec3(0.3, 1.0, 0.5))), 0.1);
+    fragColor = vec4(vec3(1.0, 0.5, 0.31) * diff, 1.0);
+}
@@ -0,0 +1,22 @@
+#version 330 core
+layout (location=0) in vec3 aPos;
+layout (location=1) in vec3 aNormal;
+
+#ifdef OBJECT_BLOCK
+layout (std140) uniform Object {
+    mat4 model;
+    mat3 normalMat;
+};
+#else
+uniform mat4 model;
+uniform mat3 normalMat;
+#endif
+
+uniform mat4 viewProj;
+
+out vec3 normal;
+
+void main() {
+    normal = normalMat * aNormal;
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
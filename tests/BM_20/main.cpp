@@ -0,0 +1,117 @@
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "camera.h"
+#include "frustum_cull.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+const uint32_t k_Frames = 100;
+const uint32_t k_Bounds = 1000000;
+const float k_WorldSize = 2000.0f; // side of the cube the bounds are scattered in
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct CullTimes {
+	double cullMs; // per frame
+	double visible; // per frame
+	uint32_t mismatches; // frames whose visible list differs from the scalar one
+};
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Boxes of random size and proportions, with the sphere around each
+CullBounds createBounds(const uint32_t count)
+{
+	std::mt19937 random(20);
+	std::uniform_real_distribution<float> position(-k_WorldSize * 0.5f, k_WorldSize * 0.5f);
+	std::uniform_real_distribution<float> size(0.5f, 10.0f);
+
+	CullBounds bounds;
+	bounds.reserve(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const glm::vec3 extents(size(random), size(random), size(random));
+		bounds.add(glm::vec3(position(random), position(random), position(random)), extents, glm::length(extents));
+	}
+	return bounds;
+}
+
+// The camera turns a full circle over the run, one frustum per frame
+std::vector<Frustum> createFrustums()
+{
+	Camera camera(0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, k_Yaw, 10.0f);
+	const float degreesPerFrame = 360.0f / k_Frames;
+	std::vector<Frustum> frustums;
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		frustums.push_back(camera.getFrustum((float)screen_width / screen_height, 0.1f, k_WorldSize));
+		camera.handleMouseMovement(degreesPerFrame / k_Sensitivity, 0.0f);
+	}
+	return frustums;
+}
+
+CullTimes cullFrames(const CullBounds& bounds, const std::vector<Frustum>& frustums, const CullPath path,
+	const std::vector<std::vector<uint32_t>>* reference, std::vector<std::vector<uint32_t>>* lists)
+{
+	CullTimes times = { 0.0, 0.0, 0 };
+	std::vector<uint32_t> visible;
+	visible.reserve(bounds.size());
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		visible.clear();
+		const auto start = Clock::now();
+		cullBounds(frustums[frame], bounds, &visible, path);
+		times.cullMs += elapsedMs(start);
+		times.visible += visible.size();
+		if (reference && visible != (*reference)[frame]) times.mismatches++;
+		if (lists) lists->push_back(visible);
+	}
+	times.cullMs /= k_Frames;
+	times.visible /= k_Frames;
+	return times;
+}
+
+void print(const CullPath path, const CullTimes& times)
+{
+	std::cout << "  " << cullPathName(path) << ": " << times.cullMs << " ms, " << times.visible << " visible, "
+		<< (times.cullMs > 0.0 ? k_Bounds / times.cullMs / 1000.0 : 0.0) << " M bounds/s";
+	if (times.mismatches) std::cout << ", " << times.mismatches << " frames differ from Scalar";
+	std::cout << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	// Only CPU work, no context needed
+	const CullBounds bounds = createBounds(k_Bounds);
+	const std::vector<Frustum> frustums = createFrustums();
+
+	std::cout << k_Bounds << " bounds per frame, best path " << cullPathName(bestCullPath()) << std::endl;
+
+	std::vector<std::vector<uint32_t>> reference;
+	print(CullPath::Scalar, cullFrames(bounds, frustums, CullPath::Scalar, nullptr, &reference));
+	const CullPath paths[2] = { CullPath::SSE, CullPath::AVX };
+	for (const CullPath path : paths)
+	{
+		if (path > bestCullPath()) continue; // not compiled in
+		print(path, cullFrames(bounds, frustums, path, &reference, nullptr));
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "scene_graph.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+const uint32_t k_Frames = 100;
+const uint32_t k_Depth = 6; // levels below the root
+const uint32_t k_Children = 8; // per node, 299593 nodes in all
+
+typedef std::chrono::high_resolution_clock Clock;
+
+struct UpdateTimes {
+	double updateMs; // per frame
+	double nodes; // world matrices recomputed per frame
+};
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void addChildren(SceneGraph& scene, const uint32_t parent, const uint32_t depth)
+{
+	if (depth == k_Depth) return;
+	for (uint32_t i = 0; i < k_Children; i++)
+	{
+		const glm::mat4 local = glm::translate(glm::rotate(glm::mat4(1.0f), glm::radians(45.0f * i), glm::vec3(0.0f, 1.0f, 0.0f)),
+			glm::vec3(1.0f, 0.0f, 0.0f));
+		const uint32_t node = scene.addNode("node" + std::to_string(scene.size()), static_cast<int32_t>(parent), local);
+		addChildren(scene, node, depth + 1);
+	}
+}
+
+// Each frame turns moved nodes about their parent, then brings the world matrices up to date
+UpdateTimes updateFrames(SceneGraph& scene, const std::vector<uint32_t>& moved)
+{
+	UpdateTimes times = { 0.0, 0.0 };
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const auto start = Clock::now();
+		for (const uint32_t node : moved)
+			scene.setLocal(node, glm::rotate(scene.local(node), 0.01f, glm::vec3(0.0f, 1.0f, 0.0f)));
+		times.nodes += scene.update();
+		times.updateMs += elapsedMs(start);
+	}
+	times.updateMs /= k_Frames;
+	times.nodes /= k_Frames;
+	return times;
+}
+
+void print(const char* label, const UpdateTimes& times)
+{
+	std::cout << "  " << label << times.updateMs << " ms, " << times.nodes << " nodes updated" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	// Only CPU work, no context needed
+	SceneGraph scene;
+	const uint32_t root = scene.addNode("root", SceneGraph::k_NoParent, glm::mat4(1.0f));
+	addChildren(scene, root, 0);
+	std::cout << scene.size() << " nodes, " << k_Depth + 1 << " levels" << std::endl;
+
+	// Leaves, then whole subtrees a level below the root, then the root
+	std::vector<uint32_t> leaves, branches;
+	for (uint32_t i = 0; i < scene.size(); i++)
+	{
+		if (scene.subtreeEnd(i) == i + 1 && leaves.size() < 100) leaves.push_back(i);
+		if (scene.parent(i) == static_cast<int32_t>(root) && branches.size() < 2) branches.push_back(i);
+	}
+	const std::vector<uint32_t> everything(1, root);
+
+	print("100 leaves moved:    ", updateFrames(scene, leaves));
+	print("2 branches moved:    ", updateFrames(scene, branches));
+	print("Root moved:          ", updateFrames(scene, everything));
+	print("Nothing moved:       ", updateFrames(scene, std::vector<uint32_t>()));
+
+	return 0;
+}
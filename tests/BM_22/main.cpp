@@ -0,0 +1,178 @@
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "camera.h"
+#include "frustum_cull.h"
+#include "occlusion_culler.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+uint32_t screen_width = 1280;
+uint32_t screen_height = 720;
+
+const uint32_t k_Frames = 100;
+const uint32_t k_GridSide = 100; // small boxes on the ground, one per unit
+const float k_WallZ = 10.0f; // the wall runs along x between the camera and most of the grid
+
+typedef std::chrono::high_resolution_clock Clock;
+
+// Unit cube, scaled and placed by each occluder's model matrix
+const glm::vec3 k_CubePositions[8] = {
+	glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, -1.0f), glm::vec3(-1.0f, 1.0f, -1.0f),
+	glm::vec3(-1.0f, -1.0f, 1.0f), glm::vec3(1.0f, -1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(-1.0f, 1.0f, 1.0f)
+};
+const uint32_t k_CubeIndices[36] = {
+	0, 2, 1, 0, 3, 2, // back
+	4, 5, 6, 4, 6, 7, // front
+	0, 1, 5, 0, 5, 4, // bottom
+	3, 6, 2, 3, 7, 6, // top
+	0, 4, 7, 0, 7, 3, // left
+	1, 2, 6, 1, 6, 5 // right
+};
+const glm::vec3 k_QuadPositions[4] = {
+	glm::vec3(-1.0f, 0.0f, -1.0f), glm::vec3(1.0f, 0.0f, -1.0f), glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(-1.0f, 0.0f, 1.0f)
+};
+const uint32_t k_QuadIndices[6] = { 0, 2, 1, 0, 3, 2 };
+
+struct CullTimes {
+	double frameMs; // frustum and occlusion culling, per frame
+	double rasterMs; // rasterization and pyramid
+	double testMs;
+	double frustumVisible; // per frame
+	double occluded;
+	uint32_t frontCulled; // boxes between the camera and the wall found hidden, must stay 0
+};
+
+#pragma region Functions: for Benchmark
+
+double elapsedMs(const Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+glm::mat4 boxTransform(const glm::vec3& center, const glm::vec3& extents)
+{
+	return glm::scale(glm::translate(glm::mat4(1.0f), center), extents);
+}
+
+// Ground, a wall and two buildings further back
+void addOccluders(OcclusionCuller& culler)
+{
+	culler.addOccluder(k_QuadPositions, 4, k_QuadIndices, 6, boxTransform(glm::vec3(0.0f), glm::vec3(200.0f, 1.0f, 200.0f)));
+	culler.addOccluder(k_CubePositions, 8, k_CubeIndices, 36, boxTransform(glm::vec3(0.0f, 2.0f, k_WallZ), glm::vec3(8.0f, 2.0f, 0.5f)));
+	culler.addOccluder(k_CubePositions, 8, k_CubeIndices, 36, boxTransform(glm::vec3(-40.0f, 8.0f, -20.0f), glm::vec3(10.0f, 8.0f, 10.0f)));
+	culler.addOccluder(k_CubePositions, 8, k_CubeIndices, 36, boxTransform(glm::vec3(40.0f, 8.0f, -20.0f), glm::vec3(10.0f, 8.0f, 10.0f)));
+}
+
+// Half unit boxes standing on the ground, from behind the buildings to just in front of the camera
+CullBounds createBoxes()
+{
+	CullBounds bounds;
+	const glm::vec3 extents(0.4f, 0.5f, 0.4f);
+	for (uint32_t z = 0; z < k_GridSide; z++)
+	{
+		for (uint32_t x = 0; x < k_GridSide; x++)
+		{
+			const glm::vec3 center(x - k_GridSide * 0.5f + 0.5f, 0.5f, z - 80.0f + 0.5f);
+			bounds.add(center, extents, glm::length(extents));
+		}
+	}
+	return bounds;
+}
+
+// The camera stands in front of the wall and sways from side to side
+std::vector<Camera> createCameras()
+{
+	std::vector<Camera> cameras;
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const float x = 15.0f * std::sin(frame * 6.2831853f / k_Frames);
+		cameras.push_back(Camera(x, 1.7f, 30.0f, 0.0f, 1.0f, 0.0f, k_Yaw, -5.0f));
+	}
+	return cameras;
+}
+
+CullTimes cullFrames(OcclusionCuller& culler, const CullBounds& bounds, const std::vector<Camera>& cameras,
+	std::vector<std::vector<uint32_t>>* lists)
+{
+	const float aspect = (float)screen_width / screen_height;
+	CullTimes times = { 0.0, 0.0, 0.0, 0.0, 0.0, 0 };
+	std::vector<uint32_t> candidates, visible;
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+	{
+		const Camera& camera = cameras[frame];
+		const auto start = Clock::now();
+		candidates.clear();
+		visible.clear();
+		cullBounds(camera.getFrustum(aspect, 0.1f, 200.0f), bounds, &candidates);
+
+		culler.begin(camera.getProjectionMatrix(aspect, 0.1f, 200.0f) * camera.getViewMatrix());
+		addOccluders(culler);
+		culler.rasterize();
+		culler.cull(bounds, candidates, &visible);
+		times.frameMs += elapsedMs(start);
+
+		const OcclusionStats& stats = culler.stats();
+		times.rasterMs += stats.rasterMs + stats.hizMs;
+		times.testMs += stats.testMs;
+		times.frustumVisible += candidates.size();
+		times.occluded += stats.culled;
+
+		// Anything between the wall and the camera is in plain sight
+		std::vector<bool> kept(bounds.size(), false);
+		for (const uint32_t i : visible) kept[i] = true;
+		for (const uint32_t i : candidates)
+		{
+			if (bounds.center(i).z > k_WallZ + 1.0f && !kept[i]) times.frontCulled++;
+		}
+		if (lists) lists->push_back(visible);
+	}
+	times.frameMs /= k_Frames;
+	times.rasterMs /= k_Frames;
+	times.testMs /= k_Frames;
+	times.frustumVisible /= k_Frames;
+	times.occluded /= k_Frames;
+	return times;
+}
+
+void print(const std::string& label, const CullTimes& times)
+{
+	std::cout << "  " << label << times.frameMs << " ms (" << times.rasterMs << " ms raster + HiZ, " << times.testMs << " ms tests), "
+		<< times.frustumVisible << " in frustum, " << times.occluded << " occluded, " << times.frontCulled << " wrongly culled" << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	// Only CPU work, no context needed
+	const CullBounds bounds = createBoxes();
+	const std::vector<Camera> cameras = createCameras();
+	const uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+	OcclusionCuller single(256, 128, 1);
+	OcclusionCuller parallel(256, 128, threads);
+	std::cout << bounds.size() << " boxes, " << single.width() << "x" << single.height() << " depth buffer, "
+		<< single.levels() << " HiZ levels" << std::endl;
+
+	std::vector<std::vector<uint32_t>> simdLists, scalarLists;
+	single.setSimd(false);
+	print("1 thread, scalar:  ", cullFrames(single, bounds, cameras, &scalarLists));
+	single.setSimd(true);
+	print("1 thread, SSE:     ", cullFrames(single, bounds, cameras, &simdLists));
+	print(std::to_string(threads) + " threads, SSE:   ", cullFrames(parallel, bounds, cameras, nullptr));
+
+	uint32_t differ = 0;
+	for (uint32_t frame = 0; frame < k_Frames; frame++)
+		if (simdLists[frame] != scalarLists[frame]) differ++;
+	std::cout << "SSE and scalar visibility differ in " << differ << " frames" << std::endl;
+
+	return 0;
+}